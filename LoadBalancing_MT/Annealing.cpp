@@ -0,0 +1,263 @@
+#include <cstdlib>
+#include <cmath>
+#include <climits>
+#include "Solver.h"
+
+using namespace std;
+
+SimulatedAnnealing::SimulatedAnnealing(const Problem& pr, SearchState& st, const Config& cfg) : Solver(pr, st, cfg) {
+
+	/*
+	 *	ALGORITHM
+	 *		   ,   ,    
+	 *		   :     5,
+	 *		   5     
+	 *		  .
+	 */
+
+	penalty = cfg.penalty;
+	if (!penalty) {
+		int max = 0;
+		for (int j = 0; j < pr.NumProg; j++) {
+			int rate = 0;
+			for (int k = pr.Adj->start[j]; k < pr.Adj->start[j + 1]; k++) {
+				rate += pr.Adj->rate[k];
+			}
+			if (rate > max)
+				max = rate;
+		}
+		penalty = max / 5 + 1;
+	}
+}
+
+bool SimulatedAnnealing::Propose(const Evaluator& ev, Step& s, Random& rnd) const {
+
+	/*
+	 *	ARGUMENTS
+	 *		ev	-   
+	 *		s	-  ;  s.delta     
+	 *			       
+	 *
+	 *	RETURN
+	 *		 ,    ,  
+	 */
+
+	if (rnd.Int(2)) {
+		s.swap = false;
+		s.a = rnd.Int(pr.NumProg);
+		s.b = sym.Representative(rnd.Int(pr.NumProc), ev.Loads());
+		if (s.b == ev.Proc(s.a))
+			return false;
+		s.delta = ev.MoveDelta(s.a, s.b) + penalty * ev.MoveOverloadDelta(s.a, s.b);
+	}
+	else {
+		s.swap = true;
+		s.a = rnd.Int(pr.NumProg);
+		s.b = rnd.Int(pr.NumProg);
+		if (ev.Proc(s.a) == ev.Proc(s.b))
+			return false;
+		s.delta = ev.SwapDelta(s.a, s.b) + penalty * ev.SwapOverloadDelta(s.a, s.b);
+	}
+	return true;
+}
+
+double SimulatedAnnealing::InitialTemperature(const Evaluator& ev, Random& rnd) const {
+
+	/*
+	 *	ALGORITHM
+	 *		  ,    
+	 *		      1/2.
+	 */
+
+	double sum = 0;
+	int c = 0;
+	Step s;
+	for (int k = 0; k < 100; k++) {
+		if (Propose(ev, s, rnd) && s.delta > 0) {
+			sum += s.delta;
+			c++;
+		}
+	}
+	return c ? sum / c / log(2.0) : 1.0;
+}
+
+void SimulatedAnnealing::Run(int w) {
+
+	/*
+	 *	ALGORITHM
+	 *		     (  , 
+	 *		   ).      delta
+	 *		,  delta <= 0,  -   exp(-delta / temp).
+	 *		  - steps    ,   
+	 *		  alpha.     1000 , 
+	 *		 ,    .
+	 */
+
+	Random rnd(cfg.seed, w);
+	Evaluator ev(Local(w));
+	int* buf = new int[pr.NumProg];
+	if (!Start(ev, buf, rnd, w > 0)) {
+		for (int j = 0; j < pr.NumProg; j++) {
+			buf[j] = rnd.Int(pr.NumProc);
+		}
+		ev.Assign(buf);
+	}
+
+	int NL_loc = INT_MAX;							//	     
+	if (ev.isCorrect()) {
+		NL_loc = ev.NetworkLoad();
+		st.Update(ev, w);
+	}
+
+	double T0 = cfg.T0 > 0 ? cfg.T0 : InitialTemperature(ev, rnd);
+	double temp = T0;
+	int steps = cfg.steps > 0 ? cfg.steps : pr.NumProg * pr.NumProc;
+	Step s;
+
+	for (ThreadStats& ts = st.stats[w]; st.Continue(ts); ts.count++, ts.idle++) {
+		for (int k = 0; k < steps; k++) {
+			if (!Propose(ev, s, rnd))
+				continue;
+			if (s.delta <= 0 || rnd.Real() < exp(-s.delta / temp)) {
+				ev.Apply(s);
+				if (ev.isCorrect() && ev.NetworkLoad() < NL_loc) {
+					NL_loc = ev.NetworkLoad();
+					ts.idle = 0;
+					st.Update(ev, w);
+				}
+			}
+		}
+		temp *= cfg.alpha;
+		if (temp < T0 * 1e-3)						//	 
+			temp = T0;
+	}
+
+	delete[] buf;
+}
+
+ParallelTempering::ParallelTempering(const Problem& pr, SearchState& st, const Config& cfg)
+	: SimulatedAnnealing(pr, st, cfg), barrier(cfg.threads, [this] { Exchange(); }), xrnd(cfg.seed, cfg.threads), round(0), stop(false) {
+	temp = new double[cfg.threads];
+	estimate = new double[cfg.threads];
+	energy = new int[cfg.threads];
+}
+
+ParallelTempering::~ParallelTempering() {
+	delete[] temp;
+	delete[] estimate;
+	delete[] energy;
+}
+
+void ParallelTempering::Exchange() {
+
+	/*
+	 *	ALGORITHM
+	 *		         T0  Tmin
+	 *		  .       
+	 *		 (    ,  -  ) 
+	 *		   min(1, exp((1/t_i - 1/t_j) * (E_i - E_j))).
+	 *		    ,   
+	 *		   .
+	 */
+
+	int T = cfg.threads;
+	if (!round) {
+		double Tmax = cfg.T0;
+		if (Tmax <= 0) {
+			for (int w = 0; w < T; w++) {
+				if (estimate[w] > Tmax)
+					Tmax = estimate[w];
+			}
+		}
+		double Tmin = cfg.Tmin > 0 ? cfg.Tmin : Tmax * 1e-3;
+		for (int w = 0; w < T; w++) {
+			temp[w] = T > 1 ? Tmax * pow(Tmin / Tmax, (double)w / (T - 1)) : sqrt(Tmax * Tmin);
+		}
+	}
+	else {
+		for (int w = 0; w < T; w++) {
+			st.stats[w].count++;
+			st.stats[w].idle++;
+		}
+
+		int* order = new int[T];					//	order[k] -   k-   
+		for (int w = 0; w < T; w++) {
+			order[w] = w;
+		}
+		for (int k = 1; k < T; k++) {
+			for (int j = k; j > 0 && temp[order[j]] > temp[order[j - 1]]; j--) {
+				int t = order[j];
+				order[j] = order[j - 1];
+				order[j - 1] = t;
+			}
+		}
+		for (int k = round % 2; k + 1 < T; k += 2) {
+			int a = order[k], b = order[k + 1];
+			double x = (1.0 / temp[a] - 1.0 / temp[b]) * (energy[a] - energy[b]);
+			if (x >= 0 || xrnd.Real() < exp(x)) {
+				double t = temp[a];
+				temp[a] = temp[b];
+				temp[b] = t;
+			}
+		}
+		delete[] order;
+	}
+
+	stop = true;									//	,       
+	for (int w = 0; w < T; w++) {
+		if (st.Continue(st.stats[w]))
+			stop = false;
+	}
+	round++;
+}
+
+void ParallelTempering::Run(int w) {
+
+	/*
+	 *	ALGORITHM
+	 *		    ,   SimulatedAnnealing,   
+	 *		 temp[w].  steps     ,
+	 *		   .   -  .
+	 */
+
+	Random rnd(cfg.seed, w);
+	Evaluator ev(Local(w));
+	int* buf = new int[pr.NumProg];
+	if (!Start(ev, buf, rnd, w > 0)) {
+		for (int j = 0; j < pr.NumProg; j++) {
+			buf[j] = rnd.Int(pr.NumProc);
+		}
+		ev.Assign(buf);
+	}
+
+	int NL_loc = INT_MAX;
+	if (ev.isCorrect()) {
+		NL_loc = ev.NetworkLoad();
+		st.Update(ev, w);
+	}
+
+	estimate[w] = cfg.T0 > 0 ? cfg.T0 : InitialTemperature(ev, rnd);
+	int steps = cfg.steps > 0 ? cfg.steps : pr.NumProg * pr.NumProc;
+	Step s;
+
+	barrier.Wait();
+	while (!stop) {
+		double t = temp[w];
+		for (int k = 0; k < steps; k++) {
+			if (!Propose(ev, s, rnd))
+				continue;
+			if (s.delta <= 0 || rnd.Real() < exp(-s.delta / t)) {
+				ev.Apply(s);
+				if (ev.isCorrect() && ev.NetworkLoad() < NL_loc) {
+					NL_loc = ev.NetworkLoad();
+					st.stats[w].idle = 0;
+					st.Update(ev, w);
+				}
+			}
+		}
+		energy[w] = ev.NetworkLoad() + penalty * ev.Overload();
+		barrier.Wait();
+	}
+
+	delete[] buf;
+}
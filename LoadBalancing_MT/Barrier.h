@@ -0,0 +1,38 @@
+#ifndef BARRIER_H
+#define BARRIER_H
+
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/*
+ *	  n .     completion,
+ *	  ,      .
+ */
+
+class Barrier {
+public:
+	Barrier(int n, std::function<void()> completion) : n(n), arrived(0), generation(0), completion(completion) {}
+
+	void Wait() {
+		std::unique_lock<std::mutex> lk(mtx);
+		int gen = generation;
+		if (++arrived == n) {
+			completion();
+			arrived = 0;
+			generation++;
+			cv.notify_all();
+		}
+		else cv.wait(lk, [&] { return gen != generation; });
+	}
+
+private:
+	std::mutex mtx;
+	std::condition_variable cv;
+	int n;
+	int arrived;				//	    
+	int generation;				//	    
+	std::function<void()> completion;
+};
+
+#endif
@@ -0,0 +1,93 @@
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "BitPlanes.h"
+
+using namespace std;
+
+BitPlanes::BitPlanes(const Problem& pr) : NumProc(pr.NumProc), NumProg(pr.NumProg) {
+
+	/*
+	 *	ALGORITHM
+	 *		      ,   
+	 *		    .     .
+	 *		      ,
+	 *		         .
+	 */
+
+	const Adjacency& adj = *pr.Adj;
+	words = (NumProg + 63) / 64;
+	bits = 0;
+	while ((1 << bits) < NumProc) {
+		bits++;
+	}
+
+	vector<int> sum(NumProg, 0), w, k;
+	vector<uint64_t> m;
+	vector<pair<pair<int, int>, int>> nb;		//	((, ), )
+	start = new int[NumProg + 1];
+	start[0] = 0;
+	for (int u = 0; u < NumProg; u++) {
+		for (int e = adj.start[u]; e < adj.start[u + 1]; e++) {
+			if ((int)adj.prog[e] > u)
+				sum[adj.prog[e]] += adj.rate[e];
+		}
+		nb.clear();
+		for (int e = adj.start[u]; e < adj.start[u + 1]; e++) {
+			int v = adj.prog[e];
+			if (v > u && sum[v]) {
+				nb.push_back(make_pair(make_pair(v / 64, sum[v]), v));
+				sum[v] = 0;
+			}
+		}
+		sort(nb.begin(), nb.end());
+		for (size_t i = 0; i < nb.size(); i++) {
+			if (!i || nb[i].first != nb[i - 1].first) {
+				k.push_back(nb[i].first.first);
+				w.push_back(nb[i].first.second);
+				m.push_back(0);
+			}
+			m.back() |= 1ULL << (nb[i].second % 64);
+		}
+		start[u + 1] = (int)m.size();
+	}
+
+	word = new int[m.size()];
+	weight = new int[m.size()];
+	mask = new uint64_t[m.size()];
+	for (size_t e = 0; e < m.size(); e++) {
+		word[e] = k[e];
+		weight[e] = w[e];
+		mask[e] = m[e];
+	}
+}
+
+BitPlanes::~BitPlanes() {
+	delete[] start;
+	delete[] word;
+	delete[] weight;
+	delete[] mask;
+}
+
+BitPlanes* CreateBitPlanes(const Problem& pr) {
+
+	/*
+	 *	ALGORITHM
+	 *		         
+	 *		( (NumProg / 8 + NumProc * words) * bits ), 
+	 *		  -   (. CutWeight).  ,
+	 *		        .
+	 */
+
+	const int MAX_PROG = 4096;
+	if (pr.NumProg > MAX_PROG || pr.NumProc < 2)
+		return NULL;
+
+	BitPlanes* bp = new BitPlanes(pr);
+	long long cost = bp->start[pr.NumProg] + ((long long)pr.NumProg / 8 + (long long)pr.NumProc * bp->words) * bp->bits;
+	if (3 * cost > 2LL * pr.NumDE) {
+		delete bp;
+		return NULL;
+	}
+	return bp;
+}
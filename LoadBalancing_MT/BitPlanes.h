@@ -0,0 +1,42 @@
+#ifndef BITPLANES_H
+#define BITPLANES_H
+
+#include <cstdint>
+#include "Problem.h"
+
+/*
+ *	    :  j  b -  b 
+ *	  j,  64   .    
+ *	 i     : AND    XOR
+ *	    b  i (. PackPlanes).
+ *
+ *	 v > u  u     , 
+ *	     ;    .
+ *	   -  popcount     
+ *	  u,   :  64   
+ *	  .     ,  
+ *	 ,  .
+ */
+
+class BitPlanes {
+public:
+	BitPlanes(const Problem& pr);
+	~BitPlanes();
+
+	BitPlanes(const BitPlanes&) = delete;
+	BitPlanes& operator=(const BitPlanes&) = delete;
+
+	int Size() const { return (bits + NumProc) * words; }	//	      (. PackPlanes)
+
+	int NumProc, NumProg;
+	int words;				//	  
+	int bits;				//	 
+	int* start;				//	   u -  start[u]  start[u + 1]
+	int* word;				//	  
+	int* weight;			//	     
+	uint64_t* mask;
+};
+
+BitPlanes* CreateBitPlanes(const Problem& pr);		//	NULL,     
+
+#endif
@@ -0,0 +1,266 @@
+#include <climits>
+#include "Solver.h"
+
+using namespace std;
+
+/*
+ *	 :  order[0], ..., order[depth - 1]  .
+ *	   u  conn[u * NumProc + i] -   
+ *	     i,  tot[u] -    .
+ *	 tot[u] - conn[u * NumProc + i] -       u  i.
+ */
+
+class BranchAndBound::Partial {
+public:
+	Partial(const Problem& pr, const BranchAndBound& bb) : pr(pr), adj(*pr.Adj), bb(bb) {
+		proc = new int[pr.NumProg];
+		load = new int[pr.NumProc];
+		conn = new int[pr.NumProg * pr.NumProc];
+		tot = new int[pr.NumProg];
+		cand = new int[(pr.NumProg + 1) * pr.NumProc];
+		Reset();
+	}
+
+	~Partial() {
+		delete[] proc;
+		delete[] load;
+		delete[] conn;
+		delete[] tot;
+		delete[] cand;
+	}
+
+	void Reset() {
+		for (int j = 0; j < pr.NumProg; j++) {
+			proc[j] = -1;
+			tot[j] = 0;
+		}
+		for (int k = 0; k < pr.NumProg * pr.NumProc; k++) {
+			conn[k] = 0;
+		}
+		for (int i = 0; i < pr.NumProc; i++) {
+			load[i] = 0;
+		}
+		cut = depth = 0;
+	}
+
+	int Cost(int p, int i) const { return tot[p] - conn[p * pr.NumProc + i]; }
+	bool Fits(int p, int i) const { return load[i] + pr.load[p] <= pr.limit[i]; }
+
+	void Assign(int p, int i) {
+		cut += Cost(p, i);
+		proc[p] = i;
+		load[i] += pr.load[p];
+		for (int k = adj.start[p]; k < adj.start[p + 1]; k++) {
+			conn[adj.prog[k] * pr.NumProc + i] += adj.rate[k];
+			tot[adj.prog[k]] += adj.rate[k];
+		}
+		depth++;
+	}
+
+	void Unassign(int p) {
+		int i = proc[p];
+		depth--;
+		for (int k = adj.start[p]; k < adj.start[p + 1]; k++) {
+			conn[adj.prog[k] * pr.NumProc + i] -= adj.rate[k];
+			tot[adj.prog[k]] -= adj.rate[k];
+		}
+		load[i] -= pr.load[p];
+		proc[p] = -1;
+		cut -= Cost(p, i);
+	}
+
+	int Bound(int limit) const {
+
+		/*
+		 *	ARGUMENTS
+		 *		limit	- ,     
+		 *
+		 *	RETURN
+		 *		         
+		 *		 INT_MAX,  -     
+		 *
+		 *	ALGORITHM
+		 *		        ,
+		 *		      .     
+		 *		 ,        .
+		 */
+
+		int ret = 0;
+		for (int k = depth; k < pr.NumProg && ret < limit; k++) {
+			int u = bb.order[k], m = INT_MAX;
+			for (int i = 0; i < pr.NumProc; i++) {
+				if (Fits(u, i) && Cost(u, i) < m)
+					m = Cost(u, i);
+			}
+			if (m == INT_MAX)
+				return INT_MAX;
+			ret += m;
+		}
+		return ret;
+	}
+
+	const Problem& pr;
+	const Adjacency& adj;
+	const BranchAndBound& bb;
+	int* proc;				//	   -1
+	int* load;				//	  
+	int* conn;
+	int* tot;
+	int* cand;				//	-     
+	int cut;				//	      
+	int depth;
+};
+
+BranchAndBound::BranchAndBound(const Problem& pr, SearchState& st, const Config& cfg)
+	: Solver(pr, st, cfg), work(cfg.threads), nodes(0), aborted(false) {
+
+	/*
+	 *	ALGORITHM
+	 *		       ,  -
+	 *		,      .   
+	 *		     ,      .
+	 *		      0.
+	 */
+
+	const Adjacency& adj = *pr.Adj;
+	int* degree = new int[pr.NumProg];
+	int* link = new int[pr.NumProg];
+	bool* used = new bool[pr.NumProg];
+	for (int j = 0; j < pr.NumProg; j++) {
+		degree[j] = link[j] = 0;
+		used[j] = false;
+		for (int k = adj.start[j]; k < adj.start[j + 1]; k++) {
+			degree[j] += adj.rate[k];
+		}
+	}
+	order = new int[pr.NumProg];
+	for (int d = 0; d < pr.NumProg; d++) {
+		int p = -1;
+		for (int j = 0; j < pr.NumProg; j++) {
+			if (!used[j] && (p < 0 || link[j] > link[p] || (link[j] == link[p] && degree[j] > degree[p])))
+				p = j;
+		}
+		order[d] = p;
+		used[p] = true;
+		for (int k = adj.start[p]; k < adj.start[p + 1]; k++) {
+			link[adj.prog[k]] += adj.rate[k];
+		}
+	}
+	delete[] degree;
+	delete[] link;
+	delete[] used;
+
+	work.Push(0, vector<int>());
+}
+
+BranchAndBound::~BranchAndBound() {
+	delete[] order;
+}
+
+void BranchAndBound::Search(Partial& s, int w) {
+
+	/*
+	 *	ALGORITHM
+	 *		 ,        .
+	 *		       
+	 *		  ;        .
+	 *		 -  ,     
+	 *		   ,      
+	 *		(. WorkStealing).
+	 *
+	 *		       BATCH,     ,
+	 *		       -.   
+	 *		       BATCH    .
+	 */
+
+	const int BATCH = 64;
+	if (aborted || st.Done())
+		return;
+	ThreadStats& ts = st.stats[w];
+	if (ts.count % BATCH == 0 && ((cfg.nodes && nodes.fetch_add(BATCH) >= cfg.nodes) || st.Expired())) {
+		aborted = true;
+		return;
+	}
+	ts.count++;
+
+	int bound = st.Bound();
+	if (s.depth == pr.NumProg) {
+		if (s.cut < bound) {
+			Evaluator ev(s.pr);
+			ev.Assign(s.proc);
+			st.Update(ev, w);
+		}
+		return;
+	}
+	int lb = s.Bound(bound - s.cut);
+	if (lb == INT_MAX || s.cut + lb >= bound)
+		return;
+
+	int p = order[s.depth], n = 0;
+	int* cand = s.cand + s.depth * pr.NumProc;
+	for (int i = 0; i < pr.NumProc; i++) {
+		if (s.Fits(p, i) && !sym.Redundant(i, s.load)) {
+			int c = n++;
+			for (; c > 0 && s.Cost(p, cand[c - 1]) > s.Cost(p, i); c--) {
+				cand[c] = cand[c - 1];
+			}
+			cand[c] = i;
+		}
+	}
+
+	for (int c = 0; c < n; c++) {
+		if (c + 1 < n && work.Hungry()) {
+			vector<int> task(s.depth + 1);
+			for (int k = 0; k < s.depth; k++) {
+				task[k] = s.proc[order[k]];
+			}
+			for (int c2 = c + 1; c2 < n; c2++) {
+				task[s.depth] = cand[c2];
+				work.Push(w, task);
+			}
+			n = c + 1;
+		}
+		s.Assign(p, cand[c]);
+		Search(s, w);
+		s.Unassign(p);
+	}
+}
+
+void BranchAndBound::Run(int w) {
+
+	/*
+	 *	ALGORITHM
+	 *		     .  
+	 *		          ,
+	 *		     -    .
+	 *		   ,     .
+	 */
+
+	Random rnd(cfg.seed, w);
+	Evaluator ev(Local(w));
+	int* buf = new int[pr.NumProg];
+	if (Start(ev, buf, rnd, w > 0))
+		st.Update(ev, w);
+	delete[] buf;
+
+	Partial s(Local(w), *this);
+	vector<int> task;
+	while (work.Next(w, task, [this] { return aborted || st.Done(); })) {
+		s.Reset();
+		for (int k = 0; k < (int)task.size(); k++) {
+			s.Assign(order[k], task[k]);
+		}
+		Search(s, w);
+		work.Done();
+	}
+
+	if (aborted && !st.Done()) {
+		ThreadStats& ts = st.stats[w];
+		long long n = ts.count;
+		ts.count = ts.idle = 0;
+		TabuSearch tabu(pr, st, cfg);
+		tabu.Localize(w, Local(w));
+		tabu.Run(w);
+		ts.count += n;
+	}
+}
@@ -0,0 +1,187 @@
+#include <cstddef>
+#include "Evaluator.h"
+#include "Kernels.h"
+
+Evaluator::Evaluator(const Problem& pr) : pr(pr), adj(*pr.Adj), nl(0), overload(0) {
+	proc = new int[pr.NumProg];
+	load = new int[pr.NumProc];
+	for (int i = 0; i < pr.NumProg; i++) {
+		proc[i] = 0;
+	}
+	for (int i = 0; i < pr.NumProc; i++) {
+		load[i] = 0;
+	}
+	planes = pr.Planes ? new uint64_t[pr.Planes->Size()] : NULL;
+}
+
+Evaluator::~Evaluator() {
+	delete[] proc;
+	delete[] load;
+	delete[] planes;
+}
+
+int Evaluator::Excess(int i, int sum) const {
+	return sum > pr.limit[i] ? sum - pr.limit[i] : 0;
+}
+
+void Evaluator::Assign(const int* assignment) {
+
+	/*
+	 *	ARGUMENTS
+	 *		assignment	-     
+	 *
+	 *	ALGORITHM
+	 *		         
+	 *		  (. ProcessorLoads),    -   
+	 *		   (. CutWeight)     (. BitPlanes).
+	 */
+
+	for (int j = 0; j < pr.NumProg; j++) {
+		proc[j] = assignment[j];
+	}
+	overload = ProcessorLoads(pr, proc, load);
+
+	if (pr.Planes) {
+		PackPlanes(*pr.Planes, proc, planes);
+		nl = PlaneCutWeight(*pr.Planes, proc, planes);
+	}
+	else nl = CutWeight(pr, proc);
+}
+
+int Evaluator::MoveDelta(int p, int to) const {
+
+	/*
+	 *	ALGORITHM
+	 *		 (p, q)   ,  q    to,
+	 *		  ,  q      p.
+	 */
+
+	int from = proc[p], ret = 0;
+	if (from == to)
+		return 0;
+	for (int k = adj.start[p]; k < adj.start[p + 1]; k++) {
+		int q = proc[adj.prog[k]];
+		if (q == from)
+			ret += adj.rate[k];
+		else if (q == to)
+			ret -= adj.rate[k];
+	}
+	return ret;
+}
+
+int Evaluator::SwapDelta(int a, int b) const {
+
+	/*
+	 *	ALGORITHM
+	 *		   .  (a, b)  
+	 *		-    ,    .
+	 */
+
+	int pa = proc[a], pb = proc[b], ret = 0;
+	if (pa == pb)
+		return 0;
+	for (int k = adj.start[a]; k < adj.start[a + 1]; k++) {
+		if ((int)adj.prog[k] == b)
+			continue;
+		int q = proc[adj.prog[k]];
+		if (q == pa)
+			ret += adj.rate[k];
+		else if (q == pb)
+			ret -= adj.rate[k];
+	}
+	for (int k = adj.start[b]; k < adj.start[b + 1]; k++) {
+		if ((int)adj.prog[k] == a)
+			continue;
+		int q = proc[adj.prog[k]];
+		if (q == pb)
+			ret += adj.rate[k];
+		else if (q == pa)
+			ret -= adj.rate[k];
+	}
+	return ret;
+}
+
+bool Evaluator::CanMove(int p, int to) const {
+	return proc[p] == to || load[to] + pr.load[p] <= pr.limit[to];
+}
+
+bool Evaluator::CanSwap(int a, int b) const {
+	int pa = proc[a], pb = proc[b];
+	int d = pr.load[b] - pr.load[a];
+	return pa == pb || (load[pa] + d <= pr.limit[pa] && load[pb] - d <= pr.limit[pb]);
+}
+
+int Evaluator::MoveOverloadDelta(int p, int to) const {
+	int from = proc[p], l = pr.load[p];
+	if (from == to)
+		return 0;
+	return Excess(from, load[from] - l) - Excess(from, load[from]) + Excess(to, load[to] + l) - Excess(to, load[to]);
+}
+
+int Evaluator::SwapOverloadDelta(int a, int b) const {
+	int pa = proc[a], pb = proc[b];
+	int d = pr.load[b] - pr.load[a];
+	if (pa == pb)
+		return 0;
+	return Excess(pa, load[pa] + d) - Excess(pa, load[pa]) + Excess(pb, load[pb] - d) - Excess(pb, load[pb]);
+}
+
+void Evaluator::Move(int p, int to) {
+	int from = proc[p];
+	if (from == to)
+		return;
+	nl += MoveDelta(p, to);
+	overload -= Excess(from, load[from]) + Excess(to, load[to]);
+	load[from] -= pr.load[p];
+	load[to] += pr.load[p];
+	overload += Excess(from, load[from]) + Excess(to, load[to]);
+	proc[p] = to;
+}
+
+void Evaluator::Swap(int a, int b) {
+	int pa = proc[a], pb = proc[b];
+	if (pa == pb)
+		return;
+	nl += SwapDelta(a, b);
+	int d = pr.load[b] - pr.load[a];
+	overload -= Excess(pa, load[pa]) + Excess(pb, load[pb]);
+	load[pa] += d;
+	load[pb] -= d;
+	overload += Excess(pa, load[pa]) + Excess(pb, load[pb]);
+	proc[a] = pb;
+	proc[b] = pa;
+}
+
+BatchEvaluator::BatchEvaluator(const Problem& pr, int n) : pr(pr), n(n) {
+	proc = new int[pr.NumProg * n];
+	load = new int[pr.NumProc * n];
+	nl = new int[n];
+	overload = new int[n];
+	for (int k = 0; k < pr.NumProg * n; k++) {
+		proc[k] = 0;
+	}
+}
+
+BatchEvaluator::~BatchEvaluator() {
+	delete[] proc;
+	delete[] load;
+	delete[] nl;
+	delete[] overload;
+}
+
+void BatchEvaluator::Set(int c, const int* assignment) {
+	for (int j = 0; j < pr.NumProg; j++) {
+		proc[j * n + c] = assignment[j];
+	}
+}
+
+void BatchEvaluator::Get(int c, int* assignment) const {
+	for (int j = 0; j < pr.NumProg; j++) {
+		assignment[j] = proc[j * n + c];
+	}
+}
+
+void BatchEvaluator::Evaluate() {
+	BatchCutWeight(pr, proc, n, nl);
+	BatchOverload(pr, proc, n, load, overload);
+}
@@ -0,0 +1,98 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include "Problem.h"
+
+/*
+ *	   :   a   b
+ *	    a  b.
+ */
+
+class Step {
+public:
+	bool swap;				//	  
+	int a, b;				//	    ,    
+	int delta;				//	  
+};
+
+/*
+ *	     .
+ *	  ,     
+ *	   .        
+ *	  ,     .
+ */
+
+class Evaluator {
+public:
+	Evaluator(const Problem& pr);
+	~Evaluator();
+
+	Evaluator(const Evaluator&) = delete;
+	Evaluator& operator=(const Evaluator&) = delete;
+
+	void Assign(const int* assignment);			//	    
+
+	int MoveDelta(int p, int to) const;			//	       p   to
+	int SwapDelta(int a, int b) const;			//	        a  b
+	bool CanMove(int p, int to) const;			//	   to     
+	bool CanSwap(int a, int b) const;			//	        
+	int MoveOverloadDelta(int p, int to) const;	//	     
+	int SwapOverloadDelta(int a, int b) const;	//	     
+
+	void Move(int p, int to);
+	void Swap(int a, int b);
+	void Apply(const Step& s) { if (s.swap) Swap(s.a, s.b); else Move(s.a, s.b); }
+
+	int NetworkLoad() const { return nl; }
+	bool isCorrect() const { return overload == 0; }
+	int Overload() const { return overload; }	//	     
+	int Load(int i) const { return load[i]; }
+	const int* Loads() const { return load; }
+	int Proc(int p) const { return proc[p]; }
+	const int* Assignment() const { return proc; }
+
+private:
+	int Excess(int i, int sum) const;
+
+	const Problem& pr;
+	const Adjacency& adj;
+	int* proc;				//	     
+	int* load;				//	    
+	int nl;					//	   
+	int overload;			//	   
+	uint64_t* planes;		//	   ,     pr.Planes
+};
+
+/*
+ *	 n        (. BatchCutWeight).
+ *	     Set,   Evaluate
+ *	         .
+ */
+
+class BatchEvaluator {
+public:
+	BatchEvaluator(const Problem& pr, int n);
+	~BatchEvaluator();
+
+	BatchEvaluator(const BatchEvaluator&) = delete;
+	BatchEvaluator& operator=(const BatchEvaluator&) = delete;
+
+	void Set(int c, const int* assignment);		//	  c
+	void Get(int c, int* assignment) const;
+	void Evaluate();
+
+	int Size() const { return n; }
+	int NetworkLoad(int c) const { return nl[c]; }
+	bool isCorrect(int c) const { return overload[c] == 0; }
+	int Overload(int c) const { return overload[c]; }
+
+private:
+	const Problem& pr;
+	int n;
+	int* proc;				//	proc[j * n + c] -   j   c
+	int* load;				//	load[i * n + c] -    i   c
+	int* nl;
+	int* overload;
+};
+
+#endif
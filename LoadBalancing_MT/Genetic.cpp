@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <climits>
+#include "Solver.h"
+
+using namespace std;
+
+GeneticSearch::GeneticSearch(const Problem& pr, SearchState& st, const Config& cfg)
+	: Solver(pr, st, cfg), barrier(cfg.threads, [this] { Select(); }), work(cfg.threads), round(0), count(0), best(LLONG_MAX), stop(false) {
+	size = cfg.population ? cfg.population : max(20, 2 * cfg.threads);
+	pop = new int[size * pr.NumProg];
+	child = new int[size * pr.NumProg];
+	next = new int[size * pr.NumProg];
+	fit = new long long[size];
+	cfit = new long long[size];
+	hash = new uint64_t[size];
+	chash = new uint64_t[size];
+	weight = pr.TotalRate() + 1;
+	for (int k = 0; k < size; k++) {
+		work.Push(k % cfg.threads, k);
+	}
+}
+
+GeneticSearch::~GeneticSearch() {
+	delete[] pop;
+	delete[] child;
+	delete[] next;
+	delete[] fit;
+	delete[] cfit;
+	delete[] hash;
+	delete[] chash;
+}
+
+void GeneticSearch::Crossover(const int* a, const int* b, int* child, Random& rnd) const {
+
+	/*
+	 *	ARGUMENTS
+	 *		a, b	-  
+	 *		child	-  
+	 *
+	 *	ALGORITHM
+	 *		        
+	 *		  (. Symmetry),     b
+	 *		   a   : ,   ,
+	 *		     .    a   1/2
+	 *		     .  
+	 *		   b,      a,  -  a.
+	 */
+
+	int P = pr.NumProc, N = pr.NumProg;
+	int* map = new int[P];						//	map[i] -  a,   i  b
+	bool* used = new bool[P];
+	bool* take = new bool[P];
+	vector<pair<int, int>> overlap;				//	(  , i_a * P + i_b)
+	for (int j = 0; j < N; j++) {
+		overlap.push_back(make_pair(0, a[j] * P + b[j]));
+	}
+	sort(overlap.begin(), overlap.end(), [](const pair<int, int>& x, const pair<int, int>& y) { return x.second < y.second; });
+	int n = 0;
+	for (int k = 0; k < N; k++) {				//	  
+		if (n && overlap[n - 1].second == overlap[k].second)
+			overlap[n - 1].first++;
+		else overlap[n++] = make_pair(1, overlap[k].second);
+	}
+	overlap.resize(n);
+	stable_sort(overlap.begin(), overlap.end(), [](const pair<int, int>& x, const pair<int, int>& y) { return x.first > y.first; });
+
+	for (int i = 0; i < P; i++) {
+		map[i] = -1;
+		used[i] = false;
+		take[i] = rnd.Int(2) != 0;
+	}
+	for (int k = 0; k < n; k++) {
+		int ia = overlap[k].second / P, ib = overlap[k].second % P;
+		if (map[ib] < 0 && !used[ia] && sym.Class(ia) == sym.Class(ib)) {
+			map[ib] = ia;
+			used[ia] = true;
+		}
+	}
+	for (int ib = 0, ia = 0; ib < P; ib++) {	//	 -    
+		if (map[ib] >= 0)
+			continue;
+		for (ia = 0; used[ia] || sym.Class(ia) != sym.Class(ib); ia++);
+		map[ib] = ia;
+		used[ia] = true;
+	}
+
+	for (int j = 0; j < N; j++) {
+		if (take[a[j]] || take[map[b[j]]])
+			child[j] = a[j];
+		else child[j] = map[b[j]];
+	}
+
+	delete[] map;
+	delete[] used;
+	delete[] take;
+}
+
+bool GeneticSearch::Repair(Evaluator& ev) const {
+
+	/*
+	 *	RETURN
+	 *		 ,    
+	 *
+	 *	ALGORITHM
+	 *		   ,     
+	 *		,       
+	 *		  .        1.
+	 *		  ,  .
+	 */
+
+	Step s;
+	s.swap = false;
+	while (!ev.isCorrect()) {
+		if (Stopped())
+			return false;
+		int od = 0;
+		for (int p = 0; p < pr.NumProg; p++) {
+			if (ev.Load(ev.Proc(p)) <= pr.limit[ev.Proc(p)])
+				continue;
+			for (int to = 0; to < pr.NumProc; to++) {
+				int o = to != ev.Proc(p) ? ev.MoveOverloadDelta(p, to) : 0;
+				if (o >= 0)
+					continue;
+				int d = ev.MoveDelta(p, to);
+				if (!od || d < s.delta || (d == s.delta && o < od)) {
+					s.a = p;
+					s.b = to;
+					s.delta = d;
+					od = o;
+				}
+			}
+		}
+		if (!od)
+			return false;
+		ev.Apply(s);
+	}
+	return true;
+}
+
+void GeneticSearch::Improve(Evaluator& ev, int* buf, int w, Random& rnd) const {
+
+	/*
+	 *	ALGORITHM
+	 *		    ,   
+	 *		 .     .
+	 *		        
+	 *		,      .
+	 */
+
+	if (!Repair(ev) && !Stopped())
+		Start(ev, buf, rnd, true);
+	Step s;
+	while (!Stopped() && BestStep(ev, s, rnd)) {
+		ev.Apply(s);
+	}
+	if (ev.isCorrect())
+		st.Update(ev, w);
+}
+
+void GeneticSearch::Store(const Evaluator& ev, int k, int* buf) {
+
+	/*
+	 *	ALGORITHM
+	 *		 FNV-1a     ,
+	 *		  ,   
+	 *		 ,   .
+	 */
+
+	int* x = child + k * pr.NumProg;
+	for (int j = 0; j < pr.NumProg; j++) {
+		x[j] = buf[j] = ev.Proc(j);
+	}
+	sym.Canonize(buf);
+	uint64_t h = 0xcbf29ce484222325ULL;
+	for (int j = 0; j < pr.NumProg; j++) {
+		h = (h ^ (uint64_t)buf[j]) * 0x100000001b3ULL;
+	}
+	cfit[k] = ev.Overload() * weight + ev.NetworkLoad();
+	chash[k] = h;
+}
+
+void GeneticSearch::Select() {
+
+	/*
+	 *	ALGORITHM
+	 *		   ,   ,
+	 *		     size   .
+	 *		  -  .    ,
+	 *		    .
+	 *		        , 
+	 *		  :  ,  .
+	 */
+
+	if (Stopped()) {
+		stop = true;
+		return;
+	}
+	int T = cfg.threads, N = pr.NumProg;
+	vector<int> order(count + size);				//	 < count -  ,  - 
+	for (int k = 0; k < count + size; k++) {
+		order[k] = k;
+	}
+	auto f = [&](int k) { return k < count ? fit[k] : cfit[k - count]; };
+	auto h = [&](int k) { return k < count ? hash[k] : chash[k - count]; };
+	stable_sort(order.begin(), order.end(), [&](int x, int y) { return f(x) < f(y) || (f(x) == f(y) && h(x) < h(y)); });
+
+	vector<long long> nfit;
+	vector<uint64_t> nhash;
+	for (int k = 0; k < count + size && (int)nfit.size() < size; k++) {
+		int x = order[k];
+		if (!nfit.empty() && nfit.back() == f(x) && nhash.back() == h(x))
+			continue;
+		const int* src = x < count ? pop + x * N : child + (x - count) * N;
+		copy(src, src + N, next + nfit.size() * N);
+		nfit.push_back(f(x));
+		nhash.push_back(h(x));
+	}
+	count = (int)nfit.size();
+	swap(pop, next);
+	copy(nfit.begin(), nfit.end(), fit);
+	copy(nhash.begin(), nhash.end(), hash);
+
+	for (int w = 0; w < T; w++) {
+		st.stats[w].count++;
+		st.stats[w].idle++;
+	}
+	if (fit[0] < best) {
+		best = fit[0];
+		for (int w = 0; w < T; w++) {
+			st.stats[w].idle = 0;
+		}
+	}
+
+	stop = true;									//	,       
+	for (int w = 0; w < T; w++) {
+		if (st.Continue(st.stats[w]))
+			stop = false;
+	}
+	round++;
+	for (int k = 0; k < size && !stop; k++) {
+		work.Push(k % T, k);
+	}
+}
+
+void GeneticSearch::Breed(Evaluator& ev, int* buf, int k, int w) {
+
+	/*
+	 *	ALGORITHM
+	 *		    ,    seed, 
+	 *		  k,      ,  
+	 *		 .     -  ,
+	 *		       
+	 *		( ,    ).
+	 *		  ,    (. Select).
+	 */
+
+	if (Stopped())
+		return;
+	Random rnd(cfg.seed ^ (uint64_t)round << 32, k);
+	if (!round) {
+		if (!Start(ev, buf, rnd, k > 0)) {
+			sym.Generate(buf, rnd);
+			ev.Assign(buf);
+		}
+	}
+	else {
+		int N = pr.NumProg;
+		int a = min(rnd.Int(count), rnd.Int(count));
+		int b = min(rnd.Int(count), rnd.Int(count));
+		Crossover(pop + a * N, pop + b * N, buf, rnd);
+		ev.Assign(buf);
+	}
+	Improve(ev, buf, w, rnd);
+	Store(ev, k, buf);
+}
+
+void GeneticSearch::Run(int w) {
+
+	/*
+	 *	ALGORITHM
+	 *		     ; , 
+	 *		,     (. WorkStealing).   ,
+	 *		   ,     
+	 *		      .   ,
+	 *		   :     .
+	 */
+
+	Evaluator ev(Local(w));
+	int* buf = new int[pr.NumProg];
+	int k;
+
+	do {
+		while (work.Next(w, k, [this] { return Stopped(); })) {
+			Breed(ev, buf, k, w);
+			work.Done();
+		}
+		barrier.Wait();
+	} while (!stop);
+
+	delete[] buf;
+}
@@ -0,0 +1,421 @@
+#include "Kernels.h"
+
+#if !defined(LB_NO_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+#define LB_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define LB_AVX2						//	MSVC   AVX2   
+#define LB_POPCNT
+#else
+#define LB_AVX2 __attribute__((target("avx2")))
+#define LB_POPCNT __attribute__((target("popcnt")))
+#endif
+#endif
+
+static int Excess(int sum, int limit) {
+	return sum > limit ? sum - limit : 0;
+}
+
+static void Histogram(const Problem& pr, const int* proc, int* load) {
+	for (int i = 0; i < pr.NumProc; i++) {
+		load[i] = 0;
+	}
+	for (int j = 0; j < pr.NumProg; j++) {
+		load[proc[j]] += pr.load[j];
+	}
+}
+
+static int ProcessorLoadsScalar(const Problem& pr, const int* proc, int* load) {
+	Histogram(pr, proc, load);
+	int ret = 0;
+	for (int i = 0; i < pr.NumProc; i++) {
+		ret += Excess(load[i], pr.limit[i]);
+	}
+	return ret;
+}
+
+static int CutWeightScalar(const Problem& pr, const int* proc) {
+	int ret = 0;
+	for (int i = 0; i < pr.NumDE; i++) {
+		if (proc[pr.prog1[i]] != proc[pr.prog2[i]])
+			ret += pr.rate[i];
+	}
+	return ret;
+}
+
+static void BatchLoads(const Problem& pr, const int* proc, int n, int* load) {
+
+	/*
+	 *	ALGORITHM
+	 *		load[i * n + c] -    i   c. 
+	 *		 ,     
+	 *		 ,    .
+	 */
+
+	for (int k = 0; k < pr.NumProc * n; k++) {
+		load[k] = 0;
+	}
+	for (int j = 0; j < pr.NumProg; j++) {
+		const int* row = proc + j * n;
+		for (int c = 0; c < n; c++) {
+			load[row[c] * n + c] += pr.load[j];
+		}
+	}
+}
+
+static void BatchCutWeightScalar(const Problem& pr, const int* proc, int n, int* nl, int from) {
+	for (int c = from; c < n; c++) {
+		nl[c] = 0;
+	}
+	for (int i = 0; i < pr.NumDE; i++) {
+		const int* a = proc + pr.prog1[i] * n;
+		const int* b = proc + pr.prog2[i] * n;
+		for (int c = from; c < n; c++) {
+			nl[c] += a[c] != b[c] ? pr.rate[i] : 0;
+		}
+	}
+}
+
+static void BatchOverloadScalar(const Problem& pr, const int* load, int n, int* overload, int from) {
+	for (int c = from; c < n; c++) {
+		overload[c] = 0;
+	}
+	for (int i = 0; i < pr.NumProc; i++) {
+		for (int c = from; c < n; c++) {
+			overload[c] += Excess(load[i * n + c], pr.limit[i]);
+		}
+	}
+}
+
+static int PopcountScalar(uint64_t x) {
+	x = x - ((x >> 1) & 0x5555555555555555ULL);
+	x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+	x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+	return (int)((x * 0x0101010101010101ULL) >> 56);
+}
+
+static void ProcessorMasks(const BitPlanes& bp, uint64_t* planes, int k, int n) {
+	uint64_t* same = planes + bp.bits * bp.words;
+	uint64_t valid = n == 64 ? ~0ULL : (1ULL << n) - 1;
+	for (int i = 0; i < bp.NumProc; i++) {
+		uint64_t s = valid;
+		for (int b = 0; b < bp.bits; b++) {
+			s &= planes[b * bp.words + k] ^ ((i >> b) & 1 ? 0 : ~0ULL);
+		}
+		same[i * bp.words + k] = s;
+	}
+}
+
+static void PackPlanesScalar(const BitPlanes& bp, const int* proc, uint64_t* planes) {
+
+	/*
+	 *	ARGUMENTS
+	 *		planes	-  bits ,   NumProc ,  words 
+	 */
+
+	for (int k = 0; k < bp.words; k++) {
+		int n = bp.NumProg - k * 64 < 64 ? bp.NumProg - k * 64 : 64;
+		const int* p = proc + k * 64;
+		for (int b = 0; b < bp.bits; b++) {
+			uint64_t w = 0;
+			for (int j = 0; j < n; j++) {
+				w |= (uint64_t)((p[j] >> b) & 1) << j;
+			}
+			planes[b * bp.words + k] = w;
+		}
+		ProcessorMasks(bp, planes, k, n);
+	}
+}
+
+static int PlaneCutWeightScalar(const BitPlanes& bp, const int* proc, const uint64_t* planes) {
+	int ret = 0;
+	for (int u = 0; u < bp.NumProg; u++) {
+		const uint64_t* same = planes + (bp.bits + proc[u]) * bp.words;
+		for (int e = bp.start[u]; e < bp.start[u + 1]; e++) {
+			ret += bp.weight[e] * PopcountScalar(bp.mask[e] & ~same[bp.word[e]]);
+		}
+	}
+	return ret;
+}
+
+#ifdef LB_X86
+
+static const int AVX2_PROC = 4;		//	     
+
+LB_AVX2 static int HorizontalSum(__m256i v) {
+	__m128i x = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+	x = _mm_add_epi32(x, _mm_shuffle_epi32(x, 0x4e));
+	x = _mm_add_epi32(x, _mm_shuffle_epi32(x, 0xb1));
+	return _mm_cvtsi128_si32(x);
+}
+
+LB_AVX2 static int ProcessorLoadsAVX2(const Problem& pr, const int* proc, int* load) {
+
+	/*
+	 *	ALGORITHM
+	 *		   (scatter-add)  AVX2 ,   
+	 *		    : 8 
+	 *		    ,   
+	 *		   -  .   
+	 *		 ,      AVX2_PROC
+	 *		  .     8 :
+	 *		max(load - limit, 0)   .
+	 */
+
+	int P = pr.NumProc, N = pr.NumProg;
+	if (P > AVX2_PROC)
+		Histogram(pr, proc, load);
+	else {
+		__m256i acc[AVX2_PROC];
+		for (int i = 0; i < P; i++) {
+			acc[i] = _mm256_setzero_si256();
+		}
+		int j = 0;
+		for (; j + 8 <= N; j += 8) {
+			__m256i p = _mm256_loadu_si256((const __m256i*)(proc + j));
+			__m256i l = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(pr.load + j)));
+			for (int i = 0; i < P; i++) {
+				__m256i m = _mm256_cmpeq_epi32(p, _mm256_set1_epi32(i));
+				acc[i] = _mm256_add_epi32(acc[i], _mm256_and_si256(m, l));
+			}
+		}
+		for (int i = 0; i < P; i++) {
+			load[i] = HorizontalSum(acc[i]);
+		}
+		for (; j < N; j++) {
+			load[proc[j]] += pr.load[j];
+		}
+	}
+
+	__m256i sum = _mm256_setzero_si256(), zero = _mm256_setzero_si256();
+	int i = 0;
+	for (; i + 8 <= P; i += 8) {
+		__m256i l = _mm256_loadu_si256((const __m256i*)(load + i));
+		__m256i c = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(pr.limit + i)));
+		sum = _mm256_add_epi32(sum, _mm256_max_epi32(_mm256_sub_epi32(l, c), zero));
+	}
+	int ret = HorizontalSum(sum);
+	for (; i < P; i++) {
+		ret += Excess(load[i], pr.limit[i]);
+	}
+	return ret;
+}
+
+LB_AVX2 static __m256i LoadIndex(const ProgIndex* p) {			//	8    32- 
+#ifdef LB_WIDE_INDEX
+	return _mm256_loadu_si256((const __m256i*)p);
+#else
+	return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)p));
+#endif
+}
+
+LB_AVX2 static int CutWeightAVX2(const Problem& pr, const int* proc) {
+
+	/*
+	 *	ALGORITHM
+	 *		     :  8    
+	 *		  gather, ,   
+	 *		     .
+	 */
+
+	__m256i sum = _mm256_setzero_si256();
+	int i = 0;
+	for (; i + 8 <= pr.NumDE; i += 8) {
+		__m256i p1 = _mm256_i32gather_epi32(proc, LoadIndex(pr.prog1 + i), 4);
+		__m256i p2 = _mm256_i32gather_epi32(proc, LoadIndex(pr.prog2 + i), 4);
+		__m256i r = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(pr.rate + i)));
+		sum = _mm256_add_epi32(sum, _mm256_andnot_si256(_mm256_cmpeq_epi32(p1, p2), r));
+	}
+	int ret = HorizontalSum(sum);
+	for (; i < pr.NumDE; i++) {
+		if (proc[pr.prog1[i]] != proc[pr.prog2[i]])
+			ret += pr.rate[i];
+	}
+	return ret;
+}
+
+LB_AVX2 static int BatchCutWeightAVX2(const Problem& pr, const int* proc, int n, int* nl) {
+
+	/*
+	 *	RETURN
+	 *		 ,     ( 8)
+	 *
+	 *	ALGORITHM
+	 *		   CutWeight,   :    
+	 *		 8        .
+	 */
+
+	int m = n & ~7;
+	for (int c = 0; c < m; c += 8) {
+		__m256i sum = _mm256_setzero_si256();
+		for (int i = 0; i < pr.NumDE; i++) {
+			__m256i a = _mm256_loadu_si256((const __m256i*)(proc + pr.prog1[i] * n + c));
+			__m256i b = _mm256_loadu_si256((const __m256i*)(proc + pr.prog2[i] * n + c));
+			sum = _mm256_add_epi32(sum, _mm256_andnot_si256(_mm256_cmpeq_epi32(a, b), _mm256_set1_epi32(pr.rate[i])));
+		}
+		_mm256_storeu_si256((__m256i*)(nl + c), sum);
+	}
+	return m;
+}
+
+LB_AVX2 static int BatchOverloadAVX2(const Problem& pr, const int* load, int n, int* overload) {
+	int m = n & ~7;
+	__m256i zero = _mm256_setzero_si256();
+	for (int c = 0; c < m; c += 8) {
+		__m256i sum = _mm256_setzero_si256();
+		for (int i = 0; i < pr.NumProc; i++) {
+			__m256i l = _mm256_loadu_si256((const __m256i*)(load + i * n + c));
+			sum = _mm256_add_epi32(sum, _mm256_max_epi32(_mm256_sub_epi32(l, _mm256_set1_epi32(pr.limit[i])), zero));
+		}
+		_mm256_storeu_si256((__m256i*)(overload + c), sum);
+	}
+	return m;
+}
+
+LB_AVX2 static void PackPlanesAVX2(const BitPlanes& bp, const int* proc, uint64_t* planes) {
+
+	/*
+	 *	ALGORITHM
+	 *		 b   8     ,
+	 *		 movemask  8     .
+	 */
+
+	for (int k = 0; k < bp.words; k++) {
+		int n = bp.NumProg - k * 64 < 64 ? bp.NumProg - k * 64 : 64;
+		const int* p = proc + k * 64;
+		for (int b = 0; b < bp.bits; b++) {
+			planes[b * bp.words + k] = 0;
+		}
+		int j = 0;
+		for (; j + 8 <= n; j += 8) {
+			__m256i v = _mm256_loadu_si256((const __m256i*)(p + j));
+			for (int b = 0; b < bp.bits; b++) {
+				__m256 s = _mm256_castsi256_ps(_mm256_sll_epi32(v, _mm_cvtsi32_si128(31 - b)));
+				planes[b * bp.words + k] |= (uint64_t)(unsigned)_mm256_movemask_ps(s) << j;
+			}
+		}
+		for (; j < n; j++) {
+			for (int b = 0; b < bp.bits; b++) {
+				planes[b * bp.words + k] |= (uint64_t)((p[j] >> b) & 1) << j;
+			}
+		}
+		ProcessorMasks(bp, planes, k, n);
+	}
+}
+
+LB_POPCNT static int PlaneCutWeightPopcnt(const BitPlanes& bp, const int* proc, const uint64_t* planes) {
+	int ret = 0;
+	for (int u = 0; u < bp.NumProg; u++) {
+		const uint64_t* same = planes + (bp.bits + proc[u]) * bp.words;
+		for (int e = bp.start[u]; e < bp.start[u + 1]; e++) {
+			uint64_t x = bp.mask[e] & ~same[bp.word[e]];
+#if defined(_M_X64) || defined(__x86_64__)
+			ret += bp.weight[e] * (int)_mm_popcnt_u64(x);
+#else
+			ret += bp.weight[e] * (_mm_popcnt_u32((uint32_t)x) + _mm_popcnt_u32((uint32_t)(x >> 32)));
+#endif
+		}
+	}
+	return ret;
+}
+
+static bool DetectAVX2() {
+#ifdef _MSC_VER
+	int r[4];
+	__cpuid(r, 0);
+	if (r[0] < 7)
+		return false;
+	__cpuid(r, 1);
+	if (!(r[2] & (1 << 27)) || !(r[2] & (1 << 28)))		//	OSXSAVE  AVX
+		return false;
+	if ((_xgetbv(0) & 6) != 6)							//	   YMM
+		return false;
+	__cpuidex(r, 7, 0);
+	return (r[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#else
+
+static bool DetectAVX2() {
+	return false;
+}
+
+#endif
+
+bool HasAVX2() {
+	static const bool ret = DetectAVX2();
+	return ret;
+}
+
+int ProcessorLoads(const Problem& pr, const int* proc, int* load) {
+
+	/*
+	 *	ARGUMENTS
+	 *		proc	-     
+	 *		load	-   NumProc     
+	 */
+
+#ifdef LB_X86
+	if (HasAVX2())
+		return ProcessorLoadsAVX2(pr, proc, load);
+#endif
+	return ProcessorLoadsScalar(pr, proc, load);
+}
+
+int CutWeight(const Problem& pr, const int* proc) {
+#ifdef LB_X86
+	if (HasAVX2())
+		return CutWeightAVX2(pr, proc);
+#endif
+	return CutWeightScalar(pr, proc);
+}
+
+void BatchCutWeight(const Problem& pr, const int* proc, int n, int* nl) {
+	int done = 0;
+#ifdef LB_X86
+	if (HasAVX2())
+		done = BatchCutWeightAVX2(pr, proc, n, nl);
+#endif
+	if (done < n)
+		BatchCutWeightScalar(pr, proc, n, nl, done);
+}
+
+void BatchOverload(const Problem& pr, const int* proc, int n, int* load, int* overload) {
+	BatchLoads(pr, proc, n, load);
+	int done = 0;
+#ifdef LB_X86
+	if (HasAVX2())
+		done = BatchOverloadAVX2(pr, load, n, overload);
+#endif
+	if (done < n)
+		BatchOverloadScalar(pr, load, n, overload, done);
+}
+
+void PackPlanes(const BitPlanes& bp, const int* proc, uint64_t* planes) {
+#ifdef LB_X86
+	if (HasAVX2()) {
+		PackPlanesAVX2(bp, proc, planes);
+		return;
+	}
+#endif
+	PackPlanesScalar(bp, proc, planes);
+}
+
+int PlaneCutWeight(const BitPlanes& bp, const int* proc, const uint64_t* planes) {
+
+	/*
+	 *	ALGORITHM
+	 *		POPCNT      AVX2,     .
+	 */
+
+#ifdef LB_X86
+	if (HasAVX2())
+		return PlaneCutWeightPopcnt(bp, proc, planes);
+#endif
+	return PlaneCutWeightScalar(bp, proc, planes);
+}
@@ -0,0 +1,30 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include "Problem.h"
+#include "BitPlanes.h"
+
+/*
+ *	     .
+ *	         AVX2;  
+ *	       .  LB_NO_SIMD
+ *	   .
+ */
+
+int ProcessorLoads(const Problem& pr, const int* proc, int* load);		//	   ,    
+int CutWeight(const Problem& pr, const int* proc);						//	  
+void PackPlanes(const BitPlanes& bp, const int* proc, uint64_t* planes);			//	    
+int PlaneCutWeight(const BitPlanes& bp, const int* proc, const uint64_t* planes);	//	     
+
+/*
+ *	  n  .    :
+ *	proc[j * n + c] -   j   c,   
+ *	       .
+ */
+
+void BatchCutWeight(const Problem& pr, const int* proc, int n, int* nl);
+void BatchOverload(const Problem& pr, const int* proc, int n, int* load, int* overload);	//	load -    NumProc * n 
+
+bool HasAVX2();															//	    AVX2
+
+#endif
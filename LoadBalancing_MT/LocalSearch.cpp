@@ -0,0 +1,172 @@
+#include <cstdlib>
+#include <climits>
+#include "Solver.h"
+
+using namespace std;
+
+/*
+ *	       (. Step).
+ *	  ,     .
+ *	         
+ *	    (. Symmetry) -     .
+ */
+
+bool Solver::BestStep(const Evaluator& ev, Step& best, Random& rnd) const {
+
+	/*
+	 *	RETURN
+	 *		 ,   ,    
+	 *
+	 *	ALGORITHM
+	 *		        delta.
+	 *		    ,  
+	 *		-    .
+	 */
+
+	best.delta = 0;
+	int s = rnd.Int(pr.NumProg);
+	for (int k = 0; k < pr.NumProg; k++) {
+		int a = (s + k) % pr.NumProg;
+		for (int to = 0; to < pr.NumProc; to++) {
+			if (to != ev.Proc(a) && !sym.Redundant(to, ev.Loads()) && ev.CanMove(a, to)) {
+				int d = ev.MoveDelta(a, to);
+				if (d < best.delta) {
+					best.swap = false;
+					best.a = a;
+					best.b = to;
+					best.delta = d;
+				}
+			}
+		}
+		for (int b = a + 1; b < pr.NumProg; b++) {
+			if (ev.Proc(a) != ev.Proc(b) && ev.CanSwap(a, b)) {
+				int d = ev.SwapDelta(a, b);
+				if (d < best.delta) {
+					best.swap = true;
+					best.a = a;
+					best.b = b;
+					best.delta = d;
+				}
+			}
+		}
+	}
+	return best.delta < 0;
+}
+
+void HillClimbing::Run(int w) {
+
+	/*
+	 *	ALGORITHM
+	 *		       
+	 *		  .     .
+	 */
+
+	Random rnd(cfg.seed, w);
+	Evaluator ev(Local(w));
+	int* buf = new int[pr.NumProg];
+	int NL_loc = INT_MAX;
+	bool started = false;
+	Step s;
+
+	for (ThreadStats& ts = st.stats[w]; st.Continue(ts); ts.count++, ts.idle++) {
+		if (!started)
+			started = Start(ev, buf, rnd, w > 0 || ts.count > 0);
+		else if (BestStep(ev, s, rnd))
+			ev.Apply(s);
+		else {										//	 
+			started = false;
+			continue;
+		}
+		if (started && ev.NetworkLoad() < NL_loc) {
+			NL_loc = ev.NetworkLoad();
+			ts.idle = 0;
+			st.Update(ev, w);
+		}
+	}
+
+	delete[] buf;
+}
+
+void TabuSearch::Run(int w) {
+
+	/*
+	 *	ALGORITHM
+	 *		      ,   
+	 *		   .     ,
+	 *		   ,   tenure .  ,
+	 *		       .
+	 */
+
+	Random rnd(cfg.seed, w);
+	Evaluator ev(Local(w));
+	int* buf = new int[pr.NumProg];
+	int* tabu = new int[pr.NumProg * pr.NumProc];	//	tabu[p * NumProc + i] -     p   i
+	int it = 0, NL_loc = INT_MAX;
+	bool started = false;
+
+	for (ThreadStats& ts = st.stats[w]; st.Continue(ts); ts.count++, ts.idle++) {
+		if (!started) {
+			if ((started = Start(ev, buf, rnd, w > 0 || ts.count > 0))) {
+				for (int k = 0; k < pr.NumProg * pr.NumProc; k++) {
+					tabu[k] = 0;
+				}
+				if (ev.NetworkLoad() < NL_loc) {
+					NL_loc = ev.NetworkLoad();
+					ts.idle = 0;
+					st.Update(ev, w);
+				}
+			}
+			continue;
+		}
+
+		it++;
+		Step best;
+		best.delta = INT_MAX;
+		for (int a = 0; a < pr.NumProg; a++) {
+			int pa = ev.Proc(a);
+			for (int to = 0; to < pr.NumProc; to++) {
+				if (to != pa && !sym.Redundant(to, ev.Loads()) && ev.CanMove(a, to)) {
+					int d = ev.MoveDelta(a, to);
+					if (d < best.delta && (tabu[a * pr.NumProc + to] <= it || ev.NetworkLoad() + d < NL_loc)) {
+						best.swap = false;
+						best.a = a;
+						best.b = to;
+						best.delta = d;
+					}
+				}
+			}
+			for (int b = a + 1; b < pr.NumProg; b++) {
+				int pb = ev.Proc(b);
+				if (pa != pb && ev.CanSwap(a, b)) {
+					int d = ev.SwapDelta(a, b);
+					if (d < best.delta && ((tabu[a * pr.NumProc + pb] <= it && tabu[b * pr.NumProc + pa] <= it) ||
+						ev.NetworkLoad() + d < NL_loc)) {
+						best.swap = true;
+						best.a = a;
+						best.b = b;
+						best.delta = d;
+					}
+				}
+			}
+		}
+		if (best.delta == INT_MAX) {				//	  
+			started = false;
+			continue;
+		}
+
+		int tenure = pr.NumProg / 10 + 5 + rnd.Int(5);
+		tabu[best.a * pr.NumProc + ev.Proc(best.a)] = it + tenure;
+		if (best.swap)
+			tabu[best.b * pr.NumProc + ev.Proc(best.b)] = it + tenure;
+		ev.Apply(best);
+
+		if (ev.NetworkLoad() < NL_loc) {
+			NL_loc = ev.NetworkLoad();
+			ts.idle = 0;
+			st.Update(ev, w);
+		}
+	}
+
+	delete[] buf;
+	delete[] tabu;
+}
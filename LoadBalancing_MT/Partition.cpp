@@ -0,0 +1,424 @@
+#include <algorithm>
+#include <climits>
+#include "Partition.h"
+#include "Solver.h"
+
+using namespace std;
+
+Partition::Partition(const Problem& pr, const SearchState& st, uint64_t seed) : pr(pr), st(st), seed(seed) {
+	const Adjacency& adj = *pr.Adj;
+	base.n = pr.NumProg;
+	base.weight.resize(pr.NumProg);
+	for (int j = 0; j < pr.NumProg; j++) {
+		base.weight[j] = pr.load[j];
+	}
+	base.start.assign(adj.start, adj.start + pr.NumProg + 1);
+	base.adj.assign(adj.prog, adj.prog + adj.start[pr.NumProg]);
+	base.rate.assign(adj.rate, adj.rate + adj.start[pr.NumProg]);
+	penalty = 1;
+	for (int k = 0; k < adj.start[pr.NumProg]; k++) {
+		penalty += adj.rate[k];
+	}
+
+	cap = 0;
+	for (int i = 0; i < pr.NumProc; i++) {
+		if (pr.limit[i] > cap)
+			cap = pr.limit[i];
+	}
+	cap /= 2;
+}
+
+bool Partition::Coarsen(const Graph& g, Graph& c, vector<int>& map, Random& rnd) const {
+
+	/*
+	 *	ARGUMENTS
+	 *		g	- ,  
+	 *		c	-  
+	 *		map	-   c,      g
+	 *
+	 *	RETURN
+	 *		 ,        10%
+	 *
+	 *	ALGORITHM
+	 *		    ,     
+	 *		         ,
+	 *		     cap.    
+	 *		,    .
+	 */
+
+	vector<int> perm(g.n), mate(g.n, -1);
+	for (int v = 0; v < g.n; v++) {
+		perm[v] = v;
+	}
+	for (int v = g.n - 1; v > 0; v--) {
+		swap(perm[v], perm[rnd.Int(v + 1)]);
+	}
+	map.assign(g.n, -1);
+	c.n = 0;
+	for (int k = 0; k < g.n; k++) {
+		int v = perm[k];
+		if (mate[v] >= 0)
+			continue;
+		int u = v, best = 0;
+		for (int e = g.start[v]; e < g.start[v + 1]; e++) {
+			int x = g.adj[e];
+			if (x != v && mate[x] < 0 && g.weight[v] + g.weight[x] <= cap && g.rate[e] > best) {
+				best = g.rate[e];
+				u = x;
+			}
+		}
+		mate[v] = u;
+		mate[u] = v;
+		map[v] = map[u] = c.n++;
+	}
+	if (c.n > g.n * 9 / 10)
+		return false;
+
+	c.weight.assign(c.n, 0);
+	c.start.assign(c.n + 1, 0);
+	c.adj.clear();
+	c.rate.clear();
+	vector<int> first(g.n, -1);					//	  g,     c
+	for (int v = 0; v < g.n; v++) {
+		if (first[map[v]] < 0)
+			first[map[v]] = v;
+	}
+	vector<int> where(c.n, -1);					//	   adj    -1
+	for (int cv = 0; cv < c.n; cv++) {
+		int v = first[cv];
+		int members[2] = { v, mate[v] };
+		for (int m = 0; m < (mate[v] == v ? 1 : 2); m++) {
+			int x = members[m];
+			c.weight[cv] += g.weight[x];
+			for (int e = g.start[x]; e < g.start[x + 1]; e++) {
+				int cu = map[g.adj[e]];
+				if (cu == cv)
+					continue;
+				if (where[cu] < 0) {
+					where[cu] = (int)c.adj.size();
+					c.adj.push_back(cu);
+					c.rate.push_back(0);
+				}
+				c.rate[where[cu]] += g.rate[e];
+			}
+		}
+		c.start[cv + 1] = (int)c.adj.size();
+		for (int e = c.start[cv]; e < c.start[cv + 1]; e++) {
+			where[c.adj[e]] = -1;
+		}
+	}
+	return true;
+}
+
+void Partition::InitialPartition(const Graph& g, vector<int>& part, Random& rnd) const {
+
+	/*
+	 *	ALGORITHM
+	 *		        (   -
+	 *		  ).    ,     
+	 *		  ,  ,     .
+	 *		   ,       .
+	 */
+
+	vector<int> order(g.n), room(pr.NumProc), conn(pr.NumProc);
+	for (int v = 0; v < g.n; v++) {
+		order[v] = v;
+	}
+	for (int v = g.n - 1; v > 0; v--) {
+		swap(order[v], order[rnd.Int(v + 1)]);
+	}
+	stable_sort(order.begin(), order.end(), [&](int a, int b) { return g.weight[a] > g.weight[b]; });
+	for (int i = 0; i < pr.NumProc; i++) {
+		room[i] = pr.limit[i];
+	}
+
+	part.assign(g.n, -1);
+	for (int k = 0; k < g.n; k++) {
+		int v = order[k];
+		fill(conn.begin(), conn.end(), 0);
+		for (int e = g.start[v]; e < g.start[v + 1]; e++) {
+			if (part[g.adj[e]] >= 0)
+				conn[part[g.adj[e]]] += g.rate[e];
+		}
+		int best = -1, spare = 0, c = 0;
+		for (int i = 0; i < pr.NumProc; i++) {
+			if (room[i] < g.weight[v])
+				continue;
+			if (best < 0 || conn[i] > conn[best])
+				best = i, c = 1;
+			else if (conn[i] == conn[best] && rnd.Int(++c) == 0)
+				best = i;
+		}
+		if (best < 0) {
+			for (int i = 1; i < pr.NumProc; i++) {
+				if (room[i] > room[spare])
+					spare = i;
+			}
+			best = spare;
+		}
+		part[v] = best;
+		room[best] -= g.weight[v];
+	}
+}
+
+void Partition::Refine(const Graph& g, vector<int>& part, Random& rnd) const {
+
+	/*
+	 *	ALGORITHM
+	 *		 Fiduccia-Mattheyses.       
+	 *		 :         
+	 *		,     ,     .
+	 *		  -     penalty   .
+	 *		       .
+	 *		   50   ;  ,
+	 *		       .
+	 *
+	 *		   O(deg * P),   O(n * P),      
+	 *		     ( -   ).
+	 *		  ,     ,   ,
+	 *		 ,       
+	 *		  .      : 
+	 *		  ,   .     : 
+	 *		         waiting , 
+	 *		    .      
+	 *		,    .
+	 */
+
+	if (st.Expired())
+		return;
+	int P = pr.NumProc;
+	vector<int> room(P), conn(g.n * P, 0);
+	vector<int> moved, from;					//	       
+	vector<char> locked(g.n);
+	vector<long long> key(g.n);					//	   :    
+	vector<int> perm(g.n), rank(g.n), stamp(g.n, 0);
+	vector<pair<long long, int>> heap;			//	(, rank );     
+	vector<vector<pair<int, int>>> waiting(P);	//	(, stamp):    ,  stamp  
+	for (int i = 0; i < P; i++) {
+		room[i] = pr.limit[i];
+	}
+	for (int v = 0; v < g.n; v++) {
+		perm[v] = v;
+		room[part[v]] -= g.weight[v];
+		for (int e = g.start[v]; e < g.start[v + 1]; e++) {
+			conn[v * P + part[g.adj[e]]] += g.rate[e];
+		}
+	}
+
+	auto excess = [](int r) { return r < 0 ? -r : 0; };
+	auto move = [&](int v, int to) {
+		int a = part[v];
+		room[a] += g.weight[v];
+		room[to] -= g.weight[v];
+		part[v] = to;
+		for (int e = g.start[v]; e < g.start[v + 1]; e++) {
+			conn[g.adj[e] * P + a] -= g.rate[e];
+			conn[g.adj[e] * P + to] += g.rate[e];
+		}
+	};
+	auto relief = [&](int v) {					//	      
+		int a = part[v];
+		return penalty * (excess(room[a]) - excess(room[a] + g.weight[v]));
+	};
+	auto push = [&](int v, long long k) {
+		key[v] = k;
+		heap.push_back(make_pair(k, rank[v]));
+		push_heap(heap.begin(), heap.end());
+	};
+	auto estimate = [&](int v) {				//	     
+		int a = part[v], top = -1;
+		stamp[v]++;
+		for (int i = 0; i < P; i++) {
+			if (i != a && (top < 0 || conn[v * P + i] > conn[v * P + top]))
+				top = i;
+		}
+		if (top >= 0)
+			push(v, conn[v * P + top] - conn[v * P + a] + relief(v));
+	};
+
+	bool expired = false;
+	for (int pass = 0; pass < 10 && !expired; pass++) {
+		for (int v = g.n - 1; v > 0; v--) {
+			swap(perm[v], perm[rnd.Int(v + 1)]);
+		}
+		heap.clear();
+		for (int i = 0; i < P; i++) {
+			waiting[i].clear();
+		}
+		for (int k = 0; k < g.n; k++) {
+			rank[perm[k]] = k;
+		}
+		for (int v = 0; v < g.n; v++) {
+			locked[v] = 0;
+			estimate(v);
+		}
+		moved.clear();
+		from.clear();
+		long long total = 0, top = 0;
+		size_t keep = 0;
+		for (int step = 0; step < g.n && moved.size() - keep < 50; step++) {
+			if ((expired = st.Expired()))
+				break;
+			int bv = -1, bt = -1;
+			long long d = 0;
+			while (!heap.empty() && bv < 0) {
+				pop_heap(heap.begin(), heap.end());
+				int v = perm[heap.back().second];
+				long long k = heap.back().first;
+				heap.pop_back();
+				if (locked[v] || k != key[v])
+					continue;
+
+				int a = part[v], to = -1;
+				d = LLONG_MIN;
+				for (int i = 0; i < P; i++) {
+					if (i == a)
+						continue;
+					int dx = excess(room[a] + g.weight[v]) - excess(room[a]) + excess(room[i] - g.weight[v]) - excess(room[i]);
+					long long x = conn[v * P + i] - conn[v * P + a] - penalty * dx;
+					if (dx <= 0 && x > d) {
+						d = x;
+						to = i;
+					}
+				}
+				if (d >= k) {
+					bv = v;
+					bt = to;
+					break;
+				}
+				long long r = relief(v);
+				stamp[v]++;
+				for (int i = 0; i < P; i++) {
+					if (i != a && conn[v * P + i] - conn[v * P + a] + r > d)
+						waiting[i].push_back(make_pair(v, stamp[v]));
+				}
+				if (to >= 0)
+					push(v, d);
+				else key[v] = LLONG_MIN;
+			}
+			if (bv < 0)
+				break;
+
+			int a = part[bv], before = excess(room[bt]);
+			locked[bv] = 1;
+			moved.push_back(bv);
+			from.push_back(a);
+			move(bv, bt);
+			total += d;
+			if (total > top) {
+				top = total;
+				keep = moved.size();
+			}
+			for (int e = g.start[bv]; e < g.start[bv + 1]; e++) {
+				if (!locked[g.adj[e]])
+					estimate(g.adj[e]);
+			}
+			size_t n = 0;						//	  a  
+			for (size_t k = 0; k < waiting[a].size(); k++) {
+				int u = waiting[a][k].first;
+				if (locked[u] || waiting[a][k].second != stamp[u])
+					continue;
+				if (excess(room[part[u]] + g.weight[u]) - excess(room[part[u]]) + excess(room[a] - g.weight[u]) - excess(room[a]) <= 0)
+					estimate(u);
+				else waiting[a][n++] = waiting[a][k];
+			}
+			waiting[a].resize(n);
+			if (excess(room[bt]) > before) {	//	  bt  
+				for (int u = 0; u < g.n; u++) {
+					if (!locked[u] && part[u] == bt)
+						estimate(u);
+				}
+			}
+		}
+		while (moved.size() > keep) {
+			move(moved.back(), from.back());
+			moved.pop_back();
+			from.pop_back();
+		}
+		if (top <= 0)
+			break;
+	}
+}
+
+void Partition::Multilevel() {
+
+	/*
+	 *	ALGORITHM
+	 *		 ,     2 * NumProc  
+	 *		.     , 
+	 *		    (   ,  ,
+	 *		    )   .   ,
+	 *		      .
+	 *		   ,      ,
+	 *		   Build .
+	 */
+
+	Random rnd(seed, ~0ULL);
+	vector<Graph> level;						//	 : level[0]   base, level[l] -  level[l - 1]
+	vector<vector<int>> map;					//	map[l] -    level[l]     
+	const Graph* g = &base;
+	while (g->n > 2 * pr.NumProc) {
+		Graph c;
+		vector<int> m;
+		if (!Coarsen(*g, c, m, rnd))
+			break;
+		level.push_back(c);
+		map.push_back(m);
+		g = &level.back();
+	}
+
+	vector<int> part, fine;
+	InitialPartition(*g, part, rnd);
+	Refine(*g, part, rnd);
+	for (int l = (int)map.size() - 1; l >= 0; l--) {
+		const Graph& f = l ? level[l - 1] : base;
+		fine.resize(f.n);
+		for (int v = 0; v < f.n; v++) {
+			fine[v] = part[map[l][v]];
+		}
+		part.swap(fine);
+		Refine(f, part, rnd);
+	}
+	result.swap(part);
+}
+
+bool Partition::Build(int* assignment, Random& rnd, bool vary) {
+
+	/*
+	 *	ALGORITHM
+	 *		     (   ),
+	 *		     .  vary, ,  
+	 *		     ,    NumProg / 10 
+	 *		    ,     .
+	 */
+
+	call_once(once, [this] { Multilevel(); });
+
+	vector<int> room(pr.NumProc);
+	for (int i = 0; i < pr.NumProc; i++) {
+		room[i] = pr.limit[i];
+	}
+	for (int j = 0; j < pr.NumProg; j++) {
+		assignment[j] = result[j];
+		room[result[j]] -= pr.load[j];
+	}
+
+	for (int k = vary ? rnd.Int(pr.NumProg / 10 + 1) : 0; k > 0; k--) {
+		int p = rnd.Int(pr.NumProg), a = assignment[p], to = -1, c = 0;
+		for (int i = 0; i < pr.NumProc; i++) {
+			if (i != a && room[i] >= pr.load[p] && rnd.Int(++c) == 0)
+				to = i;
+		}
+		if (to < 0)
+			continue;
+		room[a] += pr.load[p];
+		room[to] -= pr.load[p];
+		assignment[p] = to;
+	}
+
+	for (int i = 0; i < pr.NumProc; i++) {
+		if (room[i] < 0)
+			return false;
+	}
+	return true;
+}
@@ -0,0 +1,54 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "Problem.h"
+#include "Random.h"
+
+class SearchState;
+
+/*
+ *	   :  -    load,
+ *	 -     rate.    
+ *	 ,     ,  
+ *	         
+ *	(Fiduccia-Mattheyses).      .
+ *
+ *	     ,   -  
+ *	   . Build     .
+ */
+
+class Partition {
+public:
+	Partition(const Problem& pr, const SearchState& st, uint64_t seed);
+
+	bool Build(int* assignment, Random& rnd, bool vary);	//	 , ,   
+
+private:
+	class Graph {
+	public:
+		int n;
+		std::vector<int> weight;	//	   
+		std::vector<int> start;		//	  v   adj/rate
+		std::vector<int> adj;		//	 start[v]  start[v + 1]
+		std::vector<int> rate;
+	};
+
+	bool Coarsen(const Graph& g, Graph& c, std::vector<int>& map, Random& rnd) const;
+	void InitialPartition(const Graph& g, std::vector<int>& part, Random& rnd) const;
+	void Refine(const Graph& g, std::vector<int>& part, Random& rnd) const;
+	void Multilevel();			//	 result,   
+
+	const Problem& pr;
+	const SearchState& st;		//	 ,   
+	Graph base;					//	  
+	int cap;					//	    
+	long long penalty;			//	    ,     
+	uint64_t seed;				//	Seed ,   
+	std::once_flag once;
+	std::vector<int> result;	//	  :   
+};
+
+#endif
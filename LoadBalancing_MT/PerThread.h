@@ -0,0 +1,50 @@
+#ifndef PERTHREAD_H
+#define PERTHREAD_H
+
+#include <cstdint>
+#include <new>
+
+/*
+ *	  n ,    ,    
+ *	 -.   ,     ,
+ *	   ,       
+ *	( ),        .
+ *
+ *	  :  C++17 new   alignas  16.
+ */
+
+const int CACHE_LINE = 64;
+
+template <class T>
+class PerThread {
+public:
+	PerThread(int n) : n(n) {
+		raw = new char[(size_t)n * STRIDE + CACHE_LINE];
+		base = raw + (CACHE_LINE - (uintptr_t)raw % CACHE_LINE) % CACHE_LINE;
+		for (int w = 0; w < n; w++) {
+			new (base + (size_t)w * STRIDE) T();
+		}
+	}
+
+	~PerThread() {
+		for (int w = 0; w < n; w++) {
+			(*this)[w].~T();
+		}
+		delete[] raw;
+	}
+
+	PerThread(const PerThread&) = delete;
+	PerThread& operator=(const PerThread&) = delete;
+
+	T& operator[](int w) { return *reinterpret_cast<T*>(base + (size_t)w * STRIDE); }
+	const T& operator[](int w) const { return *reinterpret_cast<const T*>(base + (size_t)w * STRIDE); }
+
+private:
+	static const size_t STRIDE = (sizeof(T) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+
+	int n;
+	char* raw;
+	char* base;			//	  raw,  CACHE_LINE
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include <cstddef>
+#include "Problem.h"
+#include "BitPlanes.h"
+
+Adjacency::Adjacency(const Problem& pr) {
+
+	/*
+	 *	ALGORITHM
+	 *		    ,    
+	 *		    .     
+	 *		            .
+	 */
+
+	int NumProg = pr.NumProg;
+	start = new int[NumProg + 1];
+	for (int i = 0; i <= NumProg; i++) {
+		start[i] = 0;
+	}
+	for (int i = 0; i < pr.NumDE; i++) {
+		if (pr.prog1[i] != pr.prog2[i] && pr.rate[i]) {
+			start[pr.prog1[i] + 1]++;
+			start[pr.prog2[i] + 1]++;
+		}
+	}
+	for (int i = 0; i < NumProg; i++) {
+		start[i + 1] += start[i];
+	}
+
+	prog = new ProgIndex[start[NumProg]];
+	rate = new uint8_t[start[NumProg]];
+	int* pos = new int[NumProg];
+	for (int i = 0; i < NumProg; i++) {
+		pos[i] = start[i];
+	}
+	for (int i = 0; i < pr.NumDE; i++) {
+		int a = pr.prog1[i], b = pr.prog2[i];
+		if (a != b && pr.rate[i]) {
+			prog[pos[a]] = b;
+			rate[pos[a]++] = pr.rate[i];
+			prog[pos[b]] = a;
+			rate[pos[b]++] = pr.rate[i];
+		}
+	}
+	delete[] pos;
+}
+
+Adjacency::~Adjacency() {
+	delete[] start;
+	delete[] prog;
+	delete[] rate;
+}
+
+int Problem::TotalRate() const {
+	int ret = 0;
+	for (int i = 0; i < NumDE; i++) {
+		ret += rate[i];
+	}
+	return ret;
+}
+
+Problem* CopyProblem(const Problem& pr) {
+
+	/*
+	 *	ALGORITHM
+	 *		     NUMA ,  
+	 *		  ,       ,
+	 *		       ,   .
+	 */
+
+	Problem* ret = new Problem(pr);
+	ret->limit = new uint8_t[pr.NumProc];
+	ret->load = new uint8_t[pr.NumProg];
+	ret->prog1 = new ProgIndex[pr.NumDE];
+	ret->prog2 = new ProgIndex[pr.NumDE];
+	ret->rate = new uint8_t[pr.NumDE];
+	for (int i = 0; i < pr.NumProc; i++) {
+		ret->limit[i] = pr.limit[i];
+	}
+	for (int j = 0; j < pr.NumProg; j++) {
+		ret->load[j] = pr.load[j];
+	}
+	for (int i = 0; i < pr.NumDE; i++) {
+		ret->prog1[i] = pr.prog1[i];
+		ret->prog2[i] = pr.prog2[i];
+		ret->rate[i] = pr.rate[i];
+	}
+	ret->Adj = new Adjacency(*ret);
+	ret->Planes = pr.Planes != NULL ? CreateBitPlanes(*ret) : NULL;
+	return ret;
+}
+
+void DeleteProblem(Problem* pr) {
+	delete pr->Adj;
+	delete pr->Planes;
+	delete[] pr->limit;
+	delete[] pr->load;
+	delete[] pr->prog1;
+	delete[] pr->prog2;
+	delete[] pr->rate;
+	delete pr;
+}
@@ -0,0 +1,64 @@
+#ifndef PROBLEM_H
+#define PROBLEM_H
+
+#include <cstdint>
+
+/*
+ *	   .     65535 ,
+ *	      LB_WIDE_INDEX.
+ */
+
+#ifdef LB_WIDE_INDEX
+typedef uint32_t ProgIndex;
+#else
+typedef uint16_t ProgIndex;
+#endif
+
+class Problem;
+class BitPlanes;
+
+/*
+ *	      (CSR): ,   
+ *	 p,   prog/rate  start[p]  start[p + 1]. 
+ *	     ,    .
+ */
+
+class Adjacency {
+public:
+	Adjacency(const Problem& pr);
+	~Adjacency();
+
+	Adjacency(const Adjacency&) = delete;
+	Adjacency& operator=(const Adjacency&) = delete;
+
+	int* start;
+	ProgIndex* prog;		//	  
+	uint8_t* rate;			//	 
+};
+
+/*
+ *	  ,         .
+ *	    ( 60/80/100,  5/10/20  
+ *	10/50/100    ),      
+ *	     .  
+ *	    (. Evaluator).
+ */
+
+class Problem {
+public:
+	int TotalRate() const;				//	  ,      
+
+	int NumProc, NumProg, NumDE;		//	 ,    
+	uint8_t* limit;						//	     
+	uint8_t* load;						//	     
+	ProgIndex* prog1;					//	 ,    
+	ProgIndex* prog2;
+	uint8_t* rate;						//	    
+	const Adjacency* Adj;				//	  
+	const BitPlanes* Planes;			//	        NULL
+};
+
+Problem* CopyProblem(const Problem& pr);	//	        ,
+void DeleteProblem(Problem* pr);			//	     (. ThreadPool::Node)
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+/*
+ *	   xoshiro256**   .
+ *	    ,      ,
+ *	  rand().     seed   
+ *	 splitmix64,     seed   
+ *	    .
+ */
+
+class Random {
+public:
+	Random(uint64_t seed, uint64_t stream) {
+		uint64_t x = seed ^ (stream * 0x9e3779b97f4a7c15ULL);
+		for (int i = 0; i < 4; i++) {
+			uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			s[i] = z ^ (z >> 31);
+		}
+	}
+
+	uint64_t Next() {
+		uint64_t ret = Rotl(s[1] * 5, 7) * 9;
+		uint64_t t = s[1] << 17;
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = Rotl(s[3], 45);
+		return ret;
+	}
+
+	int Int(int n) {
+
+		/*
+		 *	RETURN
+		 *		     [0, n)
+		 *
+		 *	ALGORITHM
+		 *		 :  32   32-    n.
+		 *		, -     , ,
+		 *		,    rand() % n,  .   
+		 *		  ,      n.
+		 */
+
+		uint32_t range = (uint32_t)n;
+		uint64_t m = (Next() >> 32) * range;
+		uint32_t low = (uint32_t)m;
+		if (low < range) {
+			uint32_t t = (0 - range) % range;
+			while (low < t) {
+				m = (Next() >> 32) * range;
+				low = (uint32_t)m;
+			}
+		}
+		return (int)(m >> 32);
+	}
+
+	double Real() {							//	    [0, 1)
+		return (Next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+private:
+	static uint64_t Rotl(uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+
+	uint64_t s[4];
+};
+
+#endif
@@ -0,0 +1,249 @@
+#include <cstdlib>
+#include <climits>
+#include <cstring>
+#include <algorithm>
+#include "Solver.h"
+
+using namespace std;
+
+SearchState::SearchState(const Problem& pr, const Config& cfg) : stats(cfg.threads), NumProg(pr.NumProg), cfg(cfg) {
+
+	/*
+	 *	ALGORITHM
+	 *		         ,
+	 *		     .  
+	 *		 ,    .
+	 */
+
+	best.store(Pack(pr.TotalRate() + 1, 0, NONE));
+	slots = new atomic<int>[2 * cfg.threads * NumProg];
+	deadline = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(cfg.seconds));
+}
+
+SearchState::~SearchState() {
+	delete[] slots;
+}
+
+bool SearchState::Update(const Evaluator& ev, int w) {
+
+	/*
+	 *	ARGUMENTS
+	 *		ev	-      
+	 *		w	-  
+	 *
+	 *	RETURN
+	 *		 ,      
+	 *
+	 *	ALGORITHM
+	 *		       -  
+	 *		     .     
+	 *		  (   w    w)  
+	 *		compare_exchange.        ,
+	 *		 .
+	 */
+
+	int NL = ev.NetworkLoad();
+	uint64_t cur = best.load(memory_order_acquire);
+	if (NL >= Score(cur))
+		return false;
+
+	int k = 2 * w + (Slot(cur) == 2 * w);
+	atomic<int>* slot = slots + (size_t)k * NumProg;
+	for (int j = 0; j < NumProg; j++) {
+		slot[j].store(ev.Proc(j), memory_order_relaxed);
+	}
+
+	do {
+		if (NL >= Score(cur))
+			return false;
+	} while (!best.compare_exchange_weak(cur, Pack(NL, Version(cur) + 1, k), memory_order_release, memory_order_acquire));
+	return true;
+}
+
+bool SearchState::Continue(const ThreadStats& ts) const {
+
+	/*
+	 *	ALGORITHM
+	 *		 ,        ,
+	 *		     ,     
+	 *		  stagnation      .
+	 *		       ,   
+	 *		seed    .
+	 */
+
+	if (Done())
+		return false;
+	if (cfg.iterations && ts.count >= cfg.iterations)
+		return false;
+	if (cfg.stagnation && ts.idle >= cfg.stagnation)
+		return false;
+	return !Expired();
+}
+
+bool SearchState::Expired() const {
+	return cfg.seconds > 0 && chrono::steady_clock::now() >= deadline;
+}
+
+long long SearchState::Count() const {
+	long long ret = 0;
+	for (int w = 0; w < cfg.threads; w++) {
+		ret += stats[w].count;
+	}
+	return ret;
+}
+
+int SearchState::Read(int* Pr_best) const {
+
+	/*
+	 *	ALGORITHM
+	 *		   ,   -1.
+	 *		  ,      
+	 *		 ,   ,  best   .
+	 */
+
+	uint64_t b, c;
+	do {
+		b = best.load(memory_order_acquire);
+		for (int j = 0; j < NumProg; j++) {
+			Pr_best[j] = Slot(b) == NONE ? -1 : slots[(size_t)Slot(b) * NumProg + j].load(memory_order_relaxed);
+		}
+		atomic_thread_fence(memory_order_acquire);
+		c = best.load(memory_order_relaxed);
+	} while (b != c);
+	return Score(b);
+}
+
+Solver::Solver(const Problem& pr, SearchState& st, const Config& cfg) : pr(pr), st(st), cfg(cfg), sym(pr), local(cfg.threads, &pr) {
+	part = strcmp(cfg.init, "part") ? NULL : new Partition(pr, st, cfg.seed);		//	      -init part
+}
+
+Solver::~Solver() {
+	delete part;
+}
+
+bool Solver::Start(Evaluator& ev, int* buf, Random& rnd, bool vary) const {
+
+	/*
+	 *	ARGUMENTS
+	 *		ev		- ,     
+	 *		buf		-    NumProg 
+	 *		rnd		-    
+	 *		vary	-  -init part   :  
+	 *				     ,  
+	 *
+	 *	RETURN
+	 *		 ,     
+	 *
+	 *	ALGORITHM
+	 *		 -init part      
+	 *		,       (. Partition). , 
+	 *		   ,     
+	 *		   (    -   ).
+	 *		       ,  
+	 *		    .
+	 */
+
+	if (part && part->Build(buf, rnd, vary)) {
+		ev.Assign(buf);
+		return true;
+	}
+
+	int* order = new int[pr.NumProg];
+	int* room = new int[pr.NumProc];
+	for (int j = 0; j < pr.NumProg; j++) {
+		order[j] = j;
+	}
+	for (int j = pr.NumProg - 1; j > 0; j--) {
+		swap(order[j], order[rnd.Int(j + 1)]);
+	}
+	stable_sort(order, order + pr.NumProg, [&](int a, int b) { return pr.load[a] > pr.load[b]; });
+	for (int i = 0; i < pr.NumProc; i++) {
+		room[i] = pr.limit[i];
+	}
+
+	bool ret = true;
+	for (int k = 0; k < pr.NumProg && ret; k++) {
+		int p = order[k], c = 0;
+		buf[p] = -1;
+		for (int i = 0; i < pr.NumProc; i++) {
+			if (room[i] >= pr.load[p] && rnd.Int(++c) == 0)
+				buf[p] = i;
+		}
+		if (buf[p] < 0)
+			ret = false;
+		else room[buf[p]] -= pr.load[p];
+	}
+
+	if (ret)
+		ev.Assign(buf);
+
+	delete[] order;
+	delete[] room;
+	return ret;
+}
+
+void RandomSearch::Run(int w) {
+
+	/*
+	 *	ALGORITHM
+	 *		     BATCH    
+	 *		(. BatchEvaluator).   -  ,  
+	 *		       .
+	 */
+
+	const int BATCH = 16;
+	Random rnd(cfg.seed, w);							//	      
+	Evaluator ev(Local(w));							//	    
+	BatchEvaluator batch(Local(w), BATCH);				//	  
+	int* loc_Pr = new int[pr.NumProg];					//	  
+	int NL_loc = INT_MAX;								//	     
+	int c = BATCH;										//	  
+
+	for (ThreadStats& ts = st.stats[w]; st.Continue(ts); ts.count++, ts.idle++, c++) {
+		if (c == BATCH) {
+			for (c = 0; c < BATCH; c++) {
+				sym.Generate(loc_Pr, rnd);				//	      .
+				batch.Set(c, loc_Pr);					//	 -  .  -  .
+			}
+			batch.Evaluate();							//	         
+			c = 0;
+		}
+
+		if (batch.isCorrect(c) && batch.NetworkLoad(c) < NL_loc) {	//	      
+			NL_loc = batch.NetworkLoad(c);
+			ts.idle = 0;
+			batch.Get(c, loc_Pr);
+			ev.Assign(loc_Pr);
+			st.Update(ev, w);
+		}
+	}
+
+	delete[] loc_Pr;
+}
+
+Solver* CreateSolver(const Config& cfg, const Problem& pr, SearchState& st) {
+
+	/*
+	 *	ARGUMENTS
+	 *		cfg	-  , cfg.method -  
+	 *
+	 *	RETURN
+	 *		     NULL,   
+	 */
+
+	if (!strcmp(cfg.method, "random"))
+		return new RandomSearch(pr, st, cfg);
+	if (!strcmp(cfg.method, "hill"))
+		return new HillClimbing(pr, st, cfg);
+	if (!strcmp(cfg.method, "tabu"))
+		return new TabuSearch(pr, st, cfg);
+	if (!strcmp(cfg.method, "anneal"))
+		return new SimulatedAnnealing(pr, st, cfg);
+	if (!strcmp(cfg.method, "tempering"))
+		return new ParallelTempering(pr, st, cfg);
+	if (!strcmp(cfg.method, "bnb"))
+		return new BranchAndBound(pr, st, cfg);
+	if (!strcmp(cfg.method, "genetic"))
+		return new GeneticSearch(pr, st, cfg);
+	return NULL;
+}
@@ -0,0 +1,227 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+#include "Problem.h"
+#include "Evaluator.h"
+#include "Symmetry.h"
+#include "Partition.h"
+#include "Barrier.h"
+#include "WorkStealing.h"
+#include "PerThread.h"
+#include "Random.h"
+
+/*
+ *	 ,    .
+ */
+
+class Config {
+public:
+	Config() : method("random"), init("random"), threads(1), seed(0), iterations(0), seconds(0), stagnation(1000), nodes(1000000),
+		T0(0), Tmin(0), alpha(0.95), steps(0), penalty(0), population(0), pin(false), numa(false) {}
+
+	const char* method;		//	 
+	const char* init;		//	 : random - , part -   
+	int threads;			//	  T
+	uint64_t seed;			//	 seed   
+	long long iterations;	//	     (0 -  )
+	double seconds;			//	     (0 -  )
+	long long stagnation;	//	        (0 -  )
+	long long nodes;		//	        (0 -  )
+	double T0;				//	   (0 -  )
+	double Tmin;			//	     (0 - T0 / 1000)
+	double alpha;			//	 
+	int steps;				//	     (0 - NumProg * NumProc)
+	int penalty;			//	     (0 -  )
+	int population;			//	    (0 - max(20, 2 * T))
+	bool pin;				//	    
+	bool numa;				//	    NUMA       
+};
+
+/*
+ *	  .      (   -
+ *	  ,    ,   ). 
+ *	   ,      - (. PerThread).
+ */
+
+class ThreadStats {
+public:
+	ThreadStats() : count(0), idle(0) {}
+
+	long long count;		//	  
+	long long idle;			//	      
+};
+
+/*
+ *	     :   
+ *	   .
+ *
+ *	    .   ,  
+ *	        64-  best.
+ *	    :    ,  
+ *	 ,   best   compare_exchange.
+ */
+
+class SearchState {
+public:
+	SearchState(const Problem& pr, const Config& cfg);
+	~SearchState();
+
+	bool Update(const Evaluator& ev, int w);	//	   w,    
+	int Bound() const { return Score(best.load(std::memory_order_acquire)); }
+	bool Success() const { return Slot(best.load(std::memory_order_acquire)) != NONE; }
+	bool Done() const { uint64_t b = best.load(std::memory_order_acquire); return Slot(b) != NONE && !Score(b); }
+	int Read(int* Pr_best) const;				//	  ,     
+
+	bool Continue(const ThreadStats& ts) const;	//	     
+	bool Expired() const;						//	  
+	long long Count() const;					//	    
+
+	PerThread<ThreadStats> stats;	//	  ,    -
+
+private:
+	static const int NONE = 0xffff;				//	 ,    
+
+	static uint64_t Pack(int score, int version, int slot) { return (uint64_t)score << 32 | (uint64_t)(version & 0xffff) << 16 | slot; }
+	static int Score(uint64_t b) { return (int)(b >> 32); }
+	static int Version(uint64_t b) { return (int)(b >> 16) & 0xffff; }
+	static int Slot(uint64_t b) { return (int)b & 0xffff; }
+
+	std::atomic<uint64_t> best;
+	std::atomic<int>* slots;	//	2 * T   NumProg 
+	int NumProg;
+	const Config& cfg;
+	std::chrono::steady_clock::time_point deadline;
+};
+
+/*
+ *	 .  Run     T ,
+ *	w -  .
+ */
+
+class Solver {
+public:
+	Solver(const Problem& pr, SearchState& st, const Config& cfg);
+	virtual ~Solver();
+
+	virtual void Run(int w) = 0;
+	void Localize(int w, const Problem& copy) { local[w] = &copy; }	//	 w      
+
+protected:
+	const Problem& Local(int w) const { return *local[w]; }
+
+	bool Start(Evaluator& ev, int* buf, Random& rnd, bool vary) const;	//	   
+	bool BestStep(const Evaluator& ev, Step& best, Random& rnd) const;	//	   
+
+	const Problem& pr;
+	SearchState& st;
+	const Config& cfg;
+	Symmetry sym;				//	  
+	Partition* part;			//	      (  -init part)
+	std::vector<const Problem*> local;	//	    NUMA   (  - pr)
+};
+
+class RandomSearch : public Solver {				//	  
+public:
+	RandomSearch(const Problem& pr, SearchState& st, const Config& cfg) : Solver(pr, st, cfg) {}
+	void Run(int w);
+};
+
+class HillClimbing : public Solver {				//	     
+public:
+	HillClimbing(const Problem& pr, SearchState& st, const Config& cfg) : Solver(pr, st, cfg) {}
+	void Run(int w);
+};
+
+class TabuSearch : public Solver {					//	  
+public:
+	TabuSearch(const Problem& pr, SearchState& st, const Config& cfg) : Solver(pr, st, cfg) {}
+	void Run(int w);
+};
+
+class SimulatedAnnealing : public Solver {			//	 ,     
+public:
+	SimulatedAnnealing(const Problem& pr, SearchState& st, const Config& cfg);
+	void Run(int w);
+
+protected:
+	bool Propose(const Evaluator& ev, Step& s, Random& rnd) const;		//	      
+	double InitialTemperature(const Evaluator& ev, Random& rnd) const;
+
+	int penalty;
+};
+
+class ParallelTempering : public SimulatedAnnealing {	//	 :    ,
+public:													//	   
+	ParallelTempering(const Problem& pr, SearchState& st, const Config& cfg);
+	~ParallelTempering();
+	void Run(int w);
+
+private:
+	void Exchange();			//	  ,   
+
+	Barrier barrier;
+	Random xrnd;				//	  ,    
+	double* temp;				//	   
+	double* estimate;			//	     
+	int* energy;				//	    
+	int round;					//	 
+	bool stop;
+};
+
+class BranchAndBound : public Solver {			//	        
+public:
+	BranchAndBound(const Problem& pr, SearchState& st, const Config& cfg);
+	~BranchAndBound();
+	void Run(int w);
+
+	class Partial;				//	  -   
+
+private:
+	void Search(Partial& s, int w);
+
+	int* order;					//	,     
+
+	WorkStealing<std::vector<int>> work;	//	:   order[0], ..., order[size - 1]
+	std::atomic<long long> nodes;	//	     
+	std::atomic<bool> aborted;	//	  ,    
+};
+
+class GeneticSearch : public Solver {				//	 : ,  
+public:												//	 ;   -    
+	GeneticSearch(const Problem& pr, SearchState& st, const Config& cfg);
+	~GeneticSearch();
+	void Run(int w);
+
+private:
+	void Crossover(const int* a, const int* b, int* child, Random& rnd) const;
+	bool Repair(Evaluator& ev) const;			//	   
+	void Improve(Evaluator& ev, int* buf, int w, Random& rnd) const;
+	void Breed(Evaluator& ev, int* buf, int k, int w);	//	  k
+	void Store(const Evaluator& ev, int k, int* buf);	//	  k
+	void Select();				//	  ,   
+	bool Stopped() const { return st.Expired() || st.Done(); }	//	       
+
+	Barrier barrier;
+	WorkStealing<int> work;		//	   ,    
+	int round;					//	 
+	int size;					//	 
+	int count;					//	     (  )
+	int* pop;					//	 k - pop[k * NumProg], ..., pop[(k + 1) * NumProg - 1],   fit
+	int* child;					//	  
+	int* next;					//	   
+	long long* fit;				//	  * (TotalRate + 1) +   
+	long long* cfit;
+	uint64_t* hash;				//	    (. Symmetry::Canonize)
+	uint64_t* chash;
+	long long weight;			//	   
+	long long best;				//	    
+	bool stop;
+};
+
+Solver* CreateSolver(const Config& cfg, const Problem& pr, SearchState& st);
+
+#endif
@@ -1,120 +1,53 @@
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
-#include <thread>
 #include <chrono>
-#include <mutex>
+#include <cstring>
+#include <algorithm>
 #include "tinyxml.h"
+#include "Problem.h"
+#include "Solver.h"
+#include "BitPlanes.h"
+#include "ThreadPool.h"
 
 using namespace std;
 
-class Program {
-public:
-	int load;				//	    
-	int proc;				//	    
-};
-
-class Processor {
-public:
-	int limit;				//	    
-};
-
-class DataExchange {
-public:
-	int rate;				//	   
-	int prog1, prog2;		//	 ,     
-	bool dif_proc;			//	  ,   
-};
-
-int NetworkLoad(DataExchange* de, int N) {
-
-	/*
-	 *	ARGUMENTS
-	 *		de	-   ,   
-	 *		N	-   
-	 *
-	 *	RETURN
-	 *		    
-	 *
-	 *	ALGORITHM
-	 *		      
-	 *		          .
-	 */
-
-	int ret = 0;
-	for (int i = 0; i < N; i++) {
-		if (de[i].dif_proc)
-			ret += de[i].rate;
-	}
-	return ret;
-}
-
-bool isCorrect(Program* prog, Processor* proc, int NumProg, int NumProc) {
+static void Solve(const char* file, const Config& cfg, ThreadPool& pool) {
 
 	/*
 	 *	ARGUMENTS
-	 *		prog	-  
-	 *		proc	-  
-	 *		NumProg	-  
-	 *		NumProc	-  
-	 *
-	 *	RETURN
-	 *		         
-	 *		(          )
-	 *
-	 *	ALGORITHM
-	 *		    .     .
-	 *		     (prog[j].proc == i),  .
-	 *		   ,   ,    
-	 *		   .
+	 *		file	-  xml-   
+	 *		cfg		-  
+	 *		pool	-   cfg.threads 
 	 */
 
-	int sum;
-	for (int i = 0; i < NumProc; i++) {
-		sum = 0;
-		for (int j = 0; j < NumProg; j++) {
-			if (prog[j].proc == i)
-				sum += prog[j].load;
-		}
-		if (sum > proc[i].limit)
-			return false;
-	}
-	return true;
-}
-
-mutex mtx;
-
-int main(int argc, char **argv) {						//	         xml,
-	if (argc != 2) {									//	    
-		cerr << "Error! Wrong arguments" << endl;		//	    
-		exit(0);
-	}
-	
-	int T;							//	T -  
-	cin >> T;
-	cout << endl;
-
-	auto start = chrono::high_resolution_clock::now();	//	start -   
+	auto start = chrono::high_resolution_clock::now();	//	start -     
 
 	int NumProc, NumProg, NumDE;
-	Processor* Proc;
-	Program* Prog;
-	DataExchange* DE;
+	uint8_t* limit;
+	uint8_t* load;
+	ProgIndex* prog1;
+	ProgIndex* prog2;
+	uint8_t* rate;
+	int value, p1, p2;
 
 	/*
 	 *	VARIABLES
 	 *		NumProc	-  
 	 *		NumProg	-  
 	 *		NumDE	-   ,     
-	 *		Proc	-  
-	 *		Prog	-  
-	 *		DE		-   
+	 *		limit	-   
+	 *		load	-   
+	 *		prog1, prog2, rate	-      
+	 *		value, p1, p2		-   
 	 */
 
 	 /************************XML READ**************************/
 	 /*   xml-   tinyxml */
 
-	TiXmlDocument doc(argv[1]);							//	 
+	TiXmlDocument doc(file);							//	 
+	doc.SetUseArena(true);								//	    -    
+	doc.SetParseInSitu(true);							//	    -    
 	if (!doc.LoadFile()) {								//	    , 
 		cerr << "Error! Cannot use file" << endl;		//	    
 		exit(0);										//	   .
@@ -128,20 +61,21 @@ int main(int argc, char **argv) {						//	
 			exit(0);
 		}
 
-		Proc = new Processor[NumProc];
+		limit = new uint8_t[NumProc];
 		TiXmlElement* elem = note->FirstChildElement("limit");							//	      <limit>
 		int c = 0;
 		for (int i = 0; i < NumProc && elem != NULL; i++, c++) {
-			if (elem->QueryIntAttribute("value", &Proc[i].limit) == TIXML_SUCCESS) {		//	 
-				if (Proc[i].limit != 60 && Proc[i].limit != 80 && Proc[i].limit != 100) {
+			if (elem->QueryIntAttribute("value", &value) == TIXML_SUCCESS) {				//	 
+				limit[i] = (uint8_t)value;
+				if (value != 60 && value != 80 && value != 100) {
 					cerr << "Error! Uncorrect limit" << endl;
-					delete[] Proc;
+					delete[] limit;
 					exit(0);
 				}
 			}
 			else {
 				cerr << "Error! Cannot read value" << endl;
-				delete[] Proc;
+				delete[] limit;
 				exit(0);
 			}
 
@@ -163,38 +97,42 @@ int main(int argc, char **argv) {						//	
 			cerr << "Error! Uncorrect number of program" << endl;
 			exit(0);
 		}
+		if ((long long)NumProg - 1 > (long long)(ProgIndex)~0) {					//	     ProgIndex
+			cerr << "Error! Too many programs, rebuild with LB_WIDE_INDEX" << endl;
+			exit(0);
+		}
 
-		Prog = new Program[NumProg];
+		load = new uint8_t[NumProg];
 		TiXmlElement* elem = note->FirstChildElement("load");
 		int c = 0;
 		for (int i = 0; i < NumProg && elem != NULL; i++, c++) {
-			if (elem->QueryIntAttribute("value", &Prog[i].load) == TIXML_SUCCESS) {
-				if (Prog[i].load != 5 && Prog[i].load != 10 && Prog[i].load != 20) {
+			if (elem->QueryIntAttribute("value", &value) == TIXML_SUCCESS) {
+				load[i] = (uint8_t)value;
+				if (value != 5 && value != 10 && value != 20) {
 					cerr << "Error! Uncorrect load" << endl;
-					delete[] Proc;
-					delete[] Prog;
+					delete[] limit;
+					delete[] load;
 					exit(0);
 				}
-				Prog[i].proc = -1;			//	     -1
 			}
 			else {
 				cerr << "Error! Cannot read value" << endl;
-				delete[] Proc;
-				delete[] Prog;
+				delete[] limit;
+				delete[] load;
 				exit(0);
 			}
 			elem = elem->NextSiblingElement("load");
 		}
 		if (c < NumProg || elem != NULL) {
-			delete[] Proc;
-			delete[] Prog;
+			delete[] limit;
+			delete[] load;
 			cerr << "Error! Uncorrect number of program" << endl;
 			exit(0);
 		}
 	}
 	else {
 		cerr << "Error! Cannot read value" << endl;
-		delete[] Proc;
+		delete[] limit;
 		exit(0);
 	}
 
@@ -205,181 +143,98 @@ int main(int argc, char **argv) {						//	
 			exit(0);
 		}
 
-		DE = new DataExchange[NumDE];
+		prog1 = new ProgIndex[NumDE];
+		prog2 = new ProgIndex[NumDE];
+		rate = new uint8_t[NumDE];
 		TiXmlElement* elem = note->FirstChildElement("pair");
 		int c = 0;
 		for (int i = 0; i < NumDE && elem != NULL; i++, c++) {
-			if (elem->QueryIntAttribute("prog1", &DE[i].prog1) == TIXML_SUCCESS &&
-				elem->QueryIntAttribute("prog2", &DE[i].prog2) == TIXML_SUCCESS &&
-				elem->QueryIntAttribute("rate", &DE[i].rate) == TIXML_SUCCESS) {
-
-				DE[i].dif_proc = true;
-				if (DE[i].prog1 >= NumProg || DE[i].prog1 < 0 || DE[i].prog2 >= NumProg || DE[i].prog2 < 0 ||
-					(DE[i].rate && DE[i].rate != 10 && DE[i].rate != 50 && DE[i].rate != 100)) {
+			if (elem->QueryIntAttribute("prog1", &p1) == TIXML_SUCCESS &&
+				elem->QueryIntAttribute("prog2", &p2) == TIXML_SUCCESS &&
+				elem->QueryIntAttribute("rate", &value) == TIXML_SUCCESS) {
+
+				prog1[i] = (ProgIndex)p1;
+				prog2[i] = (ProgIndex)p2;
+				rate[i] = (uint8_t)value;
+				if (p1 >= NumProg || p1 < 0 || p2 >= NumProg || p2 < 0 ||
+					(value && value != 10 && value != 50 && value != 100)) {
 					cerr << "Error! Uncorrect pair of program" << endl;
-					delete[] Proc;
-					delete[] Prog;
-					delete[] DE;
+					delete[] limit;
+					delete[] load;
+					delete[] prog1;
+					delete[] prog2;
+					delete[] rate;
 					exit(0);
 				}
 			}
 			else {
 				cerr << "Error! Cannot read value" << endl;
-				delete[] Proc;
-				delete[] Prog;
-				delete[] DE;
+				delete[] limit;
+				delete[] load;
+				delete[] prog1;
+				delete[] prog2;
+				delete[] rate;
 				exit(0);
 			}
 			elem = elem->NextSiblingElement("pair");
 		}
 		if (c < NumDE || elem != NULL) {
-			delete[] Proc;
-			delete[] Prog;
-			delete[] DE;
+			delete[] limit;
+			delete[] load;
+			delete[] prog1;
+			delete[] prog2;
+			delete[] rate;
 			cerr << "Error! Uncorrect number of program pairs" << endl;
 			exit(0);
 		}
 	}
 	else {
 		cerr << "Error! Cannot read value" << endl;
-		delete[] Proc;
-		delete[] Prog;
+		delete[] limit;
+		delete[] load;
 		exit(0);
 	}
 
 	/******************  ALGORITHM  ************************/
 
-	thread* thr = new thread[T];
-	int NL_best, NL = 0, count = 0, * Pr_best, l = 0;
-	bool flag_success = false;
-	Pr_best = new int[NumProg];
-
-	/*
-	 *	VARIABLES
-	 *		NL_best			-    
-	 *		NL				-   
-	 *		count			-  
-	 *		flag_success	-        
-	 *		Pr_best			-     
-	 *		l				-     
-	 *		thr				-  
-	 */
-
-	for (int j = 0; j < NumProg; j++) {
-		Pr_best[j] = Prog[j].proc;				//	  -1
+	Problem pr = { NumProc, NumProg, NumDE, limit, load, prog1, prog2, rate, NULL, NULL };
+	Adjacency Adj(pr);												//	       
+	pr.Adj = &Adj;
+	pr.Planes = CreateBitPlanes(pr);								//	    -   
+	SearchState st(pr, cfg);										//	    
+
+	Solver* solver = CreateSolver(cfg, pr, st);
+	if (solver == NULL) {
+		cerr << "Error! Unknown method" << endl;
+		delete[] limit;
+		delete[] load;
+		delete[] prog1;
+		delete[] prog2;
+		delete[] rate;
+		exit(0);
 	}
 
-	if (!(NL_best = NetworkLoad(DE, NumDE))) {				//	     .  0,    
-		for (int w = 0; w < T; w++) {
-			thr[w] = thread([&] {									//	 
-				srand(w + time(NULL));								//	     seed    
-
-				Program* loc_Prog = new Program[NumProg];			//	    
-				for (int i = 0; i < NumProg; i++) {
-					loc_Prog[i] = Prog[i];
-				}
-
-				Processor* loc_Proc = new Processor[NumProc];
-				for (int i = 0; i < NumProc; i++) {
-					loc_Proc[i] = Proc[i];
-				}
-
-				DataExchange* loc_DE = new DataExchange[NumDE];
-				for (int i = 0; i < NumDE; i++) {
-					loc_DE[i] = DE[i];
-				}
-
-				for (int i = 0; !flag_success && i < 1000 && l < 1000; i++, count++, l++) {
-					for (int j = 0; j < NumProg; j++) {								//	   .
-						loc_Prog[j].proc = rand() % NumProc;						//	 -  .  -  .
-					}
-
-					for (int j = 0; j < NumDE; j++) {												//	   . 
-						if (loc_Prog[loc_DE[j].prog1].proc == loc_Prog[loc_DE[j].prog2].proc)		//	      .
-							loc_DE[j].dif_proc = false;
-						else loc_DE[j].dif_proc = true;
-					}
-
-					if (isCorrect(loc_Prog, loc_Proc, NumProg, NumProc)) {			//	 
-						mtx.lock();													//	   
-						flag_success = true;
-						l = 0;
-						for (int j = 0; j < NumProg; j++) {							//	  
-							Pr_best[j] = loc_Prog[j].proc;
-						}
-						mtx.unlock();
-					}
-				}
-
-				delete[] loc_Proc;
-				delete[] loc_Prog;
-				delete[] loc_DE;
-
-			});
-		}
-
+	int copies = cfg.numa ? min(pool.Nodes(), cfg.threads) : 0;		//	     NUMA
+	Problem** local = new Problem*[copies];							//	    
+	for (int k = 0; k < copies; k++) {
+		pool.Submit(k, [local, k, &pr] { local[k] = CopyProblem(pr); });
 	}
-	else {															//       0.
-		for (int w = 0; w < T; w++) {								//  
-			thr[w] = thread([&] {
-				srand(w + time(NULL));
-				Program* loc_Prog = new Program[NumProg];
-				for (int i = 0; i < NumProg; i++) {
-					loc_Prog[i] = Prog[i];
-				}
-
-				Processor* loc_Proc = new Processor[NumProc];
-				for (int i = 0; i < NumProc; i++) {
-					loc_Proc[i] = Proc[i];
-				}
-
-				DataExchange* loc_DE = new DataExchange[NumDE];
-				for (int i = 0; i < NumDE; i++) {
-					loc_DE[i] = DE[i];
-				}
-
-				for (int i = 0; i < 1000 && NL_best && l < 1000; i++, count++, l++) {
-
-					for (int j = 0; j < NumProg; j++) {
-						loc_Prog[j].proc = rand() % NumProc;
-					}
-
-					for (int j = 0; j < NumDE; j++) {
-						if (loc_Prog[loc_DE[j].prog1].proc == loc_Prog[loc_DE[j].prog2].proc)
-							loc_DE[j].dif_proc = false;
-						else loc_DE[j].dif_proc = true;
-					}
-
-					if (isCorrect(loc_Prog, loc_Proc, NumProg, NumProc)) {		//   ,    
-						mtx.lock();
-						if ((NL = NetworkLoad(loc_DE, NumDE)) < NL_best) {		//       
-							NL_best = NL;
-							flag_success = true;
-							i = 0;
-							l = 0;
-							for (int j = 0; j < NumProg; j++) {
-								Pr_best[j] = loc_Prog[j].proc;
-							}
-						}
-						mtx.unlock();
-					}
-				}
-
-				delete[] loc_Proc;
-				delete[] loc_Prog;
-				delete[] loc_DE;
-			});
-		}
+	pool.Wait();
+	for (int w = 0; w < cfg.threads && copies; w++) {
+		solver->Localize(w, *local[pool.Node(w)]);
 	}
 
-	for (int w = 0; w < T; w++) {
-		thr[w].join();
+	for (int w = 0; w < cfg.threads; w++) {							//	      
+		pool.Submit(w, [solver, w] { solver->Run(w); });
 	}
+	pool.Wait();
 
 	/********************  OUTPUT  ***********************/
-	if (flag_success) {
+	int* Pr_best = new int[NumProg];								//	    
+	int NL_best = st.Read(Pr_best);									//	   
+	if (st.Success()) {
 		cout << "success" << endl;
-		cout << count << endl;
+		cout << st.Count() << endl;
 		for (int i = 0; i < NumProg; i++) {
 			cout << Pr_best[i] << ' ';
 		}
@@ -388,17 +243,98 @@ int main(int argc, char **argv) {						//	
 	}
 	else {
 		cout << "failure" << endl;
-		cout << count << endl;
+		cout << st.Count() << endl;
 	}
 
-	delete[] Proc;
-	delete[] Prog;
-	delete[] DE;
+	delete solver;
+	for (int k = 0; k < copies; k++) {
+		DeleteProblem(local[k]);
+	}
+	delete[] local;
+	delete pr.Planes;
+	delete[] limit;
+	delete[] load;
+	delete[] prog1;
+	delete[] prog2;
+	delete[] rate;
 	delete[] Pr_best;
 
-	auto end = chrono::high_resolution_clock::now();		//   
+	auto end = chrono::high_resolution_clock::now();		//   
 	chrono::duration<float> duration = end - start;
 	cout << duration.count() << endl;
 
+}
+
+int main(int argc, char **argv) {						//	         xml,
+	int files = 1;										//	    ,   
+	while (files < argc && argv[files][0] != '-') {		//	         
+		files++;
+	}
+	if (files < 2) {
+		cerr << "Error! Wrong arguments" << endl;
+		exit(0);
+	}
+
+	Config cfg;											//	cfg -  
+	cfg.seed = time(NULL);
+	for (int i = files; i < argc; i++) {
+		if (i + 1 == argc) {
+			cerr << "Error! Wrong arguments" << endl;
+			exit(0);
+		}
+		if (!strcmp(argv[i], "-m"))						//	 : random, hill, tabu, anneal, tempering, bnb, genetic
+			cfg.method = argv[++i];
+		else if (!strcmp(argv[i], "-init"))				//	 : random, part
+			cfg.init = argv[++i];
+		else if (!strcmp(argv[i], "-seed"))				//	 seed;   seed        
+			cfg.seed = strtoull(argv[++i], NULL, 10);
+		else if (!strcmp(argv[i], "-i"))				//	 :    ,
+			cfg.iterations = atoll(argv[++i]);
+		else if (!strcmp(argv[i], "-t"))				//	    
+			cfg.seconds = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-s"))				//	    
+			cfg.stagnation = atoll(argv[++i]);
+		else if (!strcmp(argv[i], "-n"))				//	     
+			cfg.nodes = atoll(argv[++i]);
+		else if (!strcmp(argv[i], "-T0"))				//	 
+			cfg.T0 = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-Tmin"))
+			cfg.Tmin = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-alpha"))
+			cfg.alpha = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-steps"))
+			cfg.steps = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-penalty"))
+			cfg.penalty = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-pop"))				//	   
+			cfg.population = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-pin"))				//	1 -    
+			cfg.pin = atoi(argv[++i]) != 0;
+		else if (!strcmp(argv[i], "-numa"))				//	1 -     NUMA,      
+			cfg.numa = atoi(argv[++i]) != 0;
+		else {
+			cerr << "Error! Wrong arguments" << endl;
+			exit(0);
+		}
+	}
+	if (cfg.iterations < 0 || cfg.seconds < 0 || cfg.stagnation < 0 || cfg.nodes < 0 || (!cfg.iterations && !cfg.seconds && !cfg.stagnation) ||
+		cfg.T0 < 0 || cfg.Tmin < 0 || cfg.alpha <= 0 || cfg.alpha >= 1 || cfg.steps < 0 || cfg.penalty < 0 || cfg.population < 0 ||
+		(strcmp(cfg.init, "random") && strcmp(cfg.init, "part"))) {
+		cerr << "Error! Wrong arguments" << endl;
+		exit(0);
+	}
+
+	int T;							//	T -  
+	cin >> T;
+	cout << endl;
+	cfg.threads = T;
+
+	ThreadPool pool(T, cfg.pin, cfg.numa);						//	      
+	for (int f = 1; f < files; f++) {
+		if (files > 2)
+			cout << argv[f] << endl;
+		Solve(argv[f], cfg, pool);
+	}
+
 	return 0;
 }
\ No newline at end of file
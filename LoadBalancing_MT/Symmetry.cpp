@@ -0,0 +1,116 @@
+#include "Symmetry.h"
+
+Symmetry::Symmetry(const Problem& pr) : NumProc(pr.NumProc), NumProg(pr.NumProg), nc(0) {
+	cls = new int[NumProc];
+	for (int i = 0; i < NumProc; i++) {
+		cls[i] = -1;
+		for (int j = 0; j < i && cls[i] < 0; j++) {
+			if (pr.limit[j] == pr.limit[i])
+				cls[i] = cls[j];
+		}
+		if (cls[i] < 0)
+			cls[i] = nc++;
+	}
+
+	start = new int[nc + 1];
+	member = new int[NumProc];
+	for (int c = 0; c <= nc; c++) {
+		start[c] = 0;
+	}
+	for (int i = 0; i < NumProc; i++) {
+		start[cls[i] + 1]++;
+	}
+	for (int c = 0; c < nc; c++) {
+		start[c + 1] += start[c];
+	}
+	int* pos = new int[nc];
+	for (int c = 0; c < nc; c++) {
+		pos[c] = start[c];
+	}
+	for (int i = 0; i < NumProc; i++) {
+		member[pos[cls[i]]++] = i;
+	}
+	delete[] pos;
+}
+
+Symmetry::~Symmetry() {
+	delete[] cls;
+	delete[] start;
+	delete[] member;
+}
+
+bool Symmetry::Redundant(int i, const int* load) const {
+	return Representative(i, load) != i;
+}
+
+int Symmetry::Representative(int i, const int* load) const {
+	if (load[i])
+		return i;
+	for (int k = start[cls[i]]; member[k] != i; k++) {
+		if (!load[member[k]])
+			return member[k];
+	}
+	return i;
+}
+
+void Symmetry::Canonize(int* assignment) const {
+
+	/*
+	 *	ALGORITHM
+	 *		       
+	 *		     .
+	 */
+
+	int* map = new int[NumProc];
+	int* used = new int[nc];
+	for (int i = 0; i < NumProc; i++) {
+		map[i] = -1;
+	}
+	for (int c = 0; c < nc; c++) {
+		used[c] = 0;
+	}
+	for (int j = 0; j < NumProg; j++) {
+		int i = assignment[j];
+		if (map[i] < 0)
+			map[i] = member[start[cls[i]] + used[cls[i]]++];
+		assignment[j] = map[i];
+	}
+	delete[] map;
+	delete[] used;
+}
+
+void Symmetry::Generate(int* assignment, Random& rnd) const {
+
+	/*
+	 *	ALGORITHM
+	 *		      ,   
+	 *		  -  -   .
+	 *		        
+	 *		   .
+	 */
+
+	int used[64];
+	int* u = nc <= 64 ? used : new int[nc];
+	for (int c = 0; c < nc; c++) {
+		u[c] = 0;
+	}
+	for (int j = 0; j < NumProg; j++) {
+		int n = 0;
+		for (int c = 0; c < nc; c++) {
+			n += u[c] < start[c + 1] - start[c] ? u[c] + 1 : u[c];
+		}
+		int r = rnd.Int(n);
+		for (int c = 0; c < nc; c++) {
+			int k = u[c] < start[c + 1] - start[c] ? u[c] + 1 : u[c];
+			if (r < k) {
+				assignment[j] = member[start[c] + r];
+				if (r == u[c])
+					u[c]++;
+				break;
+			}
+			r -= k;
+		}
+	}
+	if (u != used)
+		delete[] u;
+}
@@ -0,0 +1,40 @@
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include "Problem.h"
+#include "Random.h"
+
+/*
+ *	    :    ,
+ *	       . 
+ *	    ,    , 
+ *	  ,   - :   
+ *	    .    k 
+ *	     k! .
+ */
+
+class Symmetry {
+public:
+	Symmetry(const Problem& pr);
+	~Symmetry();
+
+	Symmetry(const Symmetry&) = delete;
+	Symmetry& operator=(const Symmetry&) = delete;
+
+	bool Redundant(int i, const int* load) const;			//	 i ,          
+	int Representative(int i, const int* load) const;		//	   ,  i ,  i
+	void Canonize(int* assignment) const;					//	    
+	void Generate(int* assignment, Random& rnd) const;		//	     
+
+	int Classes() const { return nc; }
+	int Class(int i) const { return cls[i]; }
+
+private:
+	int NumProc, NumProg;
+	int nc;					//	 
+	int* cls;				//	  
+	int* start;				//	  c   member
+	int* member;			//	 start[c]  start[c + 1]   
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include <cstdio>
+#include "ThreadPool.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+
+ThreadPool::ThreadPool(int n, bool pin, bool numa) : n(n), pending(0), quit(false) {
+	Topology(numa);
+	queue = new deque<function<void()>>[n];
+	thr = new thread[n];
+	for (int w = 0; w < n; w++) {
+		thr[w] = thread(&ThreadPool::Work, this, w);
+		if (pin || numa)
+			Pin(w, numa);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	mtx.lock();
+	quit = true;
+	mtx.unlock();
+	ready.notify_all();
+	for (int w = 0; w < n; w++) {
+		thr[w].join();
+	}
+	delete[] thr;
+	delete[] queue;
+}
+
+void ThreadPool::Topology(bool numa) {
+
+	/*
+	 *	ALGORITHM
+	 *		  ,     ,
+	 *		  ,   (taskset, numactl, start /affinity),
+	 *		.   NUMA   /sys/devices/system/node
+	 *		 Linux   GetNumaNodeProcessorMask  Windows;   
+	 *		 .        
+	 *		,      .
+	 */
+
+	vector<bool> allowed;
+#ifdef _WIN32
+	DWORD_PTR mask, sys;
+	if (GetProcessAffinityMask(GetCurrentProcess(), &mask, &sys)) {
+		for (int i = 0; i < (int)sizeof(mask) * 8; i++) {
+			allowed.push_back((mask >> i & 1) != 0);
+		}
+	}
+	ULONG highest;
+	if (numa && GetNumaHighestNodeNumber(&highest)) {
+		for (ULONG k = 0; k <= highest; k++) {
+			ULONGLONG node;
+			if (!GetNumaNodeProcessorMask((UCHAR)k, &node))
+				continue;
+			vector<int> list;
+			for (int i = 0; i < (int)allowed.size(); i++) {
+				if (allowed[i] && (node >> i & 1))
+					list.push_back(i);
+			}
+			if (!list.empty())
+				cpu.push_back(list);
+		}
+	}
+#elif defined(__linux__)
+	cpu_set_t set;
+	if (!sched_getaffinity(0, sizeof(set), &set)) {
+		for (int i = 0; i < CPU_SETSIZE; i++) {
+			allowed.push_back(CPU_ISSET(i, &set) != 0);
+		}
+	}
+	for (int k = 0; numa; k++) {
+		char name[64];
+		sprintf(name, "/sys/devices/system/node/node%d/cpulist", k);
+		FILE* f = fopen(name, "r");
+		if (f == NULL)
+			break;
+		vector<int> list;
+		int a, b;
+		while (fscanf(f, "%d", &a) == 1) {				//	  0-3,8-11
+			b = a;
+			if (fscanf(f, "-%d", &b) < 0)
+				b = a;
+			for (int i = a; i <= b; i++) {
+				if (i < (int)allowed.size() && allowed[i])
+					list.push_back(i);
+			}
+			if (fgetc(f) != ',')
+				break;
+		}
+		fclose(f);
+		if (!list.empty())
+			cpu.push_back(list);
+	}
+#endif
+	if (cpu.empty()) {
+		vector<int> list;
+		for (int i = 0; i < (int)allowed.size(); i++) {
+			if (allowed[i])
+				list.push_back(i);
+		}
+		cpu.push_back(list);
+	}
+}
+
+void ThreadPool::Pin(int w, bool numa) {
+
+	/*
+	 *	ALGORITHM
+	 *		 numa  w       Node(w),
+	 *		   (w mod m)-  m  .
+	 *		   ,   .
+	 */
+
+	const vector<int>& list = cpu[Node(w)];
+	if (list.empty())
+		return;
+#ifdef _WIN32
+	DWORD_PTR mask = 0;
+	if (numa) {
+		for (int i : list) {
+			mask |= (DWORD_PTR)1 << i;
+		}
+	}
+	else mask = (DWORD_PTR)1 << list[w % list.size()];
+	SetThreadAffinityMask(thr[w].native_handle(), mask);
+#elif defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (numa) {
+		for (int i : list) {
+			CPU_SET(i, &set);
+		}
+	}
+	else CPU_SET(list[w % list.size()], &set);
+	pthread_setaffinity_np(thr[w].native_handle(), sizeof(set), &set);
+#else
+	(void)numa;
+#endif
+}
+
+void ThreadPool::Submit(int w, function<void()> task) {
+	mtx.lock();
+	queue[w].push_back(task);
+	pending++;
+	mtx.unlock();
+	ready.notify_all();
+}
+
+void ThreadPool::Wait() {
+	unique_lock<mutex> lk(mtx);
+	done.wait(lk, [this] { return !pending; });
+}
+
+void ThreadPool::Work(int w) {
+	unique_lock<mutex> lk(mtx);
+	for (;;) {
+		ready.wait(lk, [&] { return quit || !queue[w].empty(); });
+		if (queue[w].empty())
+			return;
+		function<void()> task = queue[w].front();
+		queue[w].pop_front();
+		lk.unlock();
+		task();
+		lk.lock();
+		if (!--pending)
+			done.notify_all();
+	}
+}
@@ -0,0 +1,51 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <vector>
+
+/*
+ *	  n  .      ,
+ *	 ,   w,    w -
+ *	   ,  Run(w)   w  .
+ *	         .
+ *
+ *	    NUMA  :  w   
+ *	Node(w).    ,   .
+ */
+
+class ThreadPool {
+public:
+	ThreadPool(int n, bool pin, bool numa);		//	pin -   w  w-  ,
+	~ThreadPool();								//	numa -      
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void Submit(int w, std::function<void()> task);		//	     w
+	void Wait();										//	    
+	int Size() const { return n; }
+	int Nodes() const { return (int)cpu.size(); }
+	int Node(int w) const { return w % Nodes(); }
+
+private:
+	void Work(int w);
+	void Topology(bool numa);
+	void Pin(int w, bool numa);
+
+	int n;
+	std::thread* thr;
+	std::deque<std::function<void()>>* queue;	//	   
+	std::mutex mtx;								//	 , pending  quit
+	std::condition_variable ready;				//	    
+	std::condition_variable done;				//	  
+	int pending;								//	      
+	bool quit;
+	std::vector<std::vector<int>> cpu;			//	    
+};
+
+#endif
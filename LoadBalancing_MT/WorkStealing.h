@@ -0,0 +1,114 @@
+#ifndef WORKSTEALING_H
+#define WORKSTEALING_H
+
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <utility>
+#include "PerThread.h"
+
+/*
+ *	      n .   
+ *	 :       (  -
+ *	  ),       
+ *	(   ).     Done,
+ *	     ,    .
+ */
+
+template <class Task>
+class WorkStealing {
+public:
+	WorkStealing(int n) : n(n), queue(n), pending(0), hungry(0) {}
+
+	WorkStealing(const WorkStealing&) = delete;
+	WorkStealing& operator=(const WorkStealing&) = delete;
+
+	void Push(int w, Task task) {				//	     w
+		pending++;
+		Queue& q = queue[w];
+		std::lock_guard<std::mutex> lk(q.mtx);
+		q.tasks.push_back(std::move(task));
+	}
+
+	bool Pop(int w, Task& task) {
+
+		/*
+		 *	RETURN
+		 *		 ,        
+		 */
+
+		{
+			Queue& q = queue[w];
+			std::lock_guard<std::mutex> lk(q.mtx);
+			if (!q.tasks.empty()) {
+				task = std::move(q.tasks.back());
+				q.tasks.pop_back();
+				return true;
+			}
+		}
+		for (int k = 1; k < n; k++) {
+			Queue& q = queue[(w + k) % n];
+			std::lock_guard<std::mutex> lk(q.mtx);
+			if (!q.tasks.empty()) {
+				task = std::move(q.tasks.front());
+				q.tasks.pop_front();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template <class Stop>
+	bool Next(int w, Task& task, Stop stop) {
+
+		/*
+		 *	ARGUMENTS
+		 *		stop	- ,      
+		 *
+		 *	RETURN
+		 *		  false,       stop()
+		 *
+		 *	ALGORITHM
+		 *		  ,    (. Hungry)  ,
+		 *		     ,   .
+		 */
+
+		bool waiting = false, ret = false;
+		while (!stop()) {
+			if (Pop(w, task)) {
+				ret = true;
+				break;
+			}
+			if (!waiting) {
+				hungry++;
+				waiting = true;
+			}
+			if (!pending)
+				break;
+			std::this_thread::yield();
+		}
+		if (waiting)
+			hungry--;
+		return ret;
+	}
+
+	void Done() { pending--; }					//	,   Pop  Next, 
+	bool Hungry() const { return hungry > 0; }	//	    -    
+	bool Empty() const { return !pending; }
+
+private:
+	class Queue {
+	public:
+		std::mutex mtx;
+		std::deque<Task> tasks;
+	};
+
+	int n;
+	PerThread<Queue> queue;		//	      -   
+	std::atomic<int> pending;	//	      
+	char pad[CACHE_LINE];		//	pending  hungry   -
+	std::atomic<int> hungry;	//	   ;    
+};
+
+#endif
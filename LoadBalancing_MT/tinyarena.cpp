@@ -0,0 +1,129 @@
+/*
+www.sourceforge.net/projects/tinyxml
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any
+damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any
+purpose, including commercial applications, and to alter it and
+redistribute it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must
+not claim that you wrote the original software. If you use this
+software in a product, an acknowledgment in the product documentation
+would be appreciated but is not required.
+
+2. Altered source versions must be plainly marked as such, and
+must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any source
+distribution.
+*/
+
+#include <new>
+#include "tinyarena.h"
+
+thread_local TiXmlArena* TiXmlArena::current = 0;
+
+// Blocks are preceded by one slot with their arena, or null for the heap.
+// Arena blocks have one more slot in front of that with the size asked
+// for, so that the newest block can be given back or grown (see Extend).
+union TiXmlArenaSlot
+{
+	TiXmlArena* arena;
+	size_t size;
+	double align;
+};
+
+
+TiXmlArena::TiXmlArena() : chunks( 0 ), cur( 0 ), end( 0 ), next( MIN_CHUNK ), used( 0 )
+{
+}
+
+
+TiXmlArena::~TiXmlArena()
+{
+	while ( chunks )
+	{
+		Chunk* c = chunks;
+		chunks = c->next;
+		::operator delete( c );
+	}
+}
+
+
+void* TiXmlArena::Bump( size_t size )
+{
+	size = Round( size );
+	if ( (size_t)( end - cur ) < size )
+	{
+		// Requests bigger than a chunk get a chunk of their own.
+		size_t bytes = size > next ? size : next;
+		Chunk* c = static_cast<Chunk*>( ::operator new( sizeof( Chunk ) + bytes ) );
+		c->next = chunks;
+		c->size = bytes;
+		chunks = c;
+		cur = reinterpret_cast<char*>( c + 1 );
+		end = cur + bytes;
+		if ( next < MAX_CHUNK )
+			next *= 2;
+	}
+	void* p = cur;
+	cur += size;
+	used += size;
+	return p;
+}
+
+
+void* TiXmlArena::Allocate( size_t size )
+{
+	TiXmlArenaSlot* h;
+	if ( current )
+	{
+		h = static_cast<TiXmlArenaSlot*>( current->Bump( 2 * sizeof( TiXmlArenaSlot ) + size ) ) + 1;
+		h[-1].size = size;
+	}
+	else
+	{
+		h = static_cast<TiXmlArenaSlot*>( ::operator new( sizeof( TiXmlArenaSlot ) + size ) );
+	}
+	h->arena = current;
+	return h + 1;
+}
+
+
+void TiXmlArena::Free( void* p )
+{
+	if ( !p )
+		return;
+	TiXmlArenaSlot* h = static_cast<TiXmlArenaSlot*>( p ) - 1;
+	TiXmlArena* a = h->arena;
+	if ( !a )
+	{
+		::operator delete( h );
+	}
+	else if ( a->cur == static_cast<char*>( p ) + Round( h[-1].size ) )
+	{
+		// The newest block: give it back, so the next one reuses the space.
+		size_t size = Round( 2 * sizeof( TiXmlArenaSlot ) + h[-1].size );
+		a->cur -= size;
+		a->used -= size;
+	}
+}
+
+
+bool TiXmlArena::Extend( void* p, size_t size )
+{
+	TiXmlArenaSlot* h = static_cast<TiXmlArenaSlot*>( p ) - 1;
+	TiXmlArena* a = h->arena;
+	if ( !a )
+		return false;
+	char* top = static_cast<char*>( p ) + Round( h[-1].size );
+	if ( a->cur != top || a->end - static_cast<char*>( p ) < (ptrdiff_t)Round( size ) )
+		return false;
+	a->cur = static_cast<char*>( p ) + Round( size );
+	a->used += a->cur - top;
+	h[-1].size = size;
+	return true;
+}
@@ -0,0 +1,112 @@
+/*
+www.sourceforge.net/projects/tinyxml
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any
+damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any
+purpose, including commercial applications, and to alter it and
+redistribute it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must
+not claim that you wrote the original software. If you use this
+software in a product, an acknowledgment in the product documentation
+would be appreciated but is not required.
+
+2. Altered source versions must be plainly marked as such, and
+must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any source
+distribution.
+*/
+
+
+#ifndef TINYXML_ARENA_INCLUDED
+#define TINYXML_ARENA_INCLUDED
+
+#include <stddef.h>
+
+/**
+	A bump allocator for the nodes, attributes and strings of one document.
+
+	Loading a large document creates a node, an attribute or a string for
+	almost every token, and tearing it down frees each one again. With an
+	arena, the document takes that memory from a few large blocks instead and
+	gives all of it back at once when the document is destroyed.
+
+	Every block handed out by Allocate() is preceded by the arena it came
+	from (null for the heap), so Free() works for both and
+	nodes from either source can be mixed in one tree. Freeing an arena
+	block only gives its memory back if it is the newest block of the arena;
+	otherwise the memory is reclaimed with the arena. For the same reason the
+	newest block can grow in place (see Extend), which is what a string being
+	appended to while it is parsed needs.
+
+	An arena only receives allocations while a TiXmlArena::Scope for it is
+	alive on the current thread (TiXmlDocument opens one around Parse()).
+	Objects created outside a scope - clones, nodes built by the program -
+	come from the heap as usual.
+*/
+class TiXmlArena
+{
+public:
+	TiXmlArena();
+	~TiXmlArena();
+
+	/// Total number of bytes handed out by this arena, including headers.
+	size_t Used() const		{ return used; }
+
+	/// Allocate from the current arena of this thread, or from the heap if there is none.
+	static void* Allocate( size_t size );
+	/// Release a block from Allocate(). Arena blocks other than the newest are left to their arena.
+	static void Free( void* p );
+	/** Try to grow a block from Allocate() to 'size' bytes without moving it.
+		Succeeds only for the newest block of an arena with enough room left.
+	*/
+	static bool Extend( void* p, size_t size );
+
+	/// Routes allocations on the current thread to 'arena' for its lifetime. Scopes nest.
+	class Scope
+	{
+	public:
+		Scope( TiXmlArena* arena ) : prev( current )	{ current = arena; }
+		~Scope()										{ current = prev; }
+
+	private:
+		Scope( const Scope& );
+		void operator=( const Scope& );
+
+		TiXmlArena* prev;
+	};
+
+private:
+	TiXmlArena( const TiXmlArena& );			// not implemented.
+	void operator=( const TiXmlArena& );		// not implemented.
+
+	void* Bump( size_t size );
+	static size_t Round( size_t size )	{ return ( size + ALIGN - 1 ) / ALIGN * ALIGN; }
+
+	struct Chunk
+	{
+		Chunk* next;
+		size_t size;
+	};
+
+	enum
+	{
+		ALIGN = 8,						// alignment of every block; enough for all TinyXML objects
+		MIN_CHUNK = 64 * 1024,
+		MAX_CHUNK = 1024 * 1024
+	};
+
+	Chunk* chunks;		// newest first
+	char* cur;			// free space of the newest chunk
+	char* end;
+	size_t next;		// size of the next chunk; doubles up to MAX_CHUNK
+	size_t used;
+
+	static thread_local TiXmlArena* current;
+};
+
+#endif
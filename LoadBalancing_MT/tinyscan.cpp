@@ -0,0 +1,201 @@
+/*
+www.sourceforge.net/projects/tinyxml
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any
+damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any
+purpose, including commercial applications, and to alter it and
+redistribute it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must
+not claim that you wrote the original software. If you use this
+software in a product, an acknowledgment in the product documentation
+would be appreciated but is not required.
+
+2. Altered source versions must be plainly marked as such, and
+must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any source
+distribution.
+*/
+
+#include "tinyscan.h"
+
+#if !defined(TIXML_NO_SIMD) && ( defined(_M_X64) || defined(__x86_64__) )
+	#define TIXML_SSE2		// part of every x86-64 processor
+	#include <stdint.h>
+	#include <immintrin.h>
+	// TIXML_ALIGNED_SCAN: the loads may cover bytes outside the text (see tinyscan.h),
+	// which the address sanitizer would report.
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#define TIXML_AVX2
+		#ifdef __SANITIZE_ADDRESS__
+			#define TIXML_ALIGNED_SCAN __declspec(no_sanitize_address)
+		#else
+			#define TIXML_ALIGNED_SCAN
+		#endif
+	#else
+		#define TIXML_AVX2 __attribute__((target("avx2")))
+		#define TIXML_ALIGNED_SCAN __attribute__((no_sanitize_address))
+	#endif
+#endif
+
+
+#ifdef TIXML_SSE2
+
+static inline unsigned LowestBit( unsigned mask )
+{
+	#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward( &index, mask );
+		return index;
+	#else
+		return __builtin_ctz( mask );
+	#endif
+}
+
+
+// The bytes of a block that are white space: ' ', or '\t' to '\r' (c - '\t' <= 4 unsigned).
+static inline __m128i Spaces( __m128i v )
+{
+	__m128i d = _mm_sub_epi8( v, _mm_set1_epi8( '\t' ) );
+	__m128i range = _mm_cmpeq_epi8( _mm_min_epu8( d, _mm_set1_epi8( '\r' - '\t' ) ), d );
+	return _mm_or_si128( range, _mm_cmpeq_epi8( v, _mm_set1_epi8( ' ' ) ) );
+}
+
+
+TIXML_AVX2 static inline __m256i Spaces( __m256i v )
+{
+	__m256i d = _mm256_sub_epi8( v, _mm256_set1_epi8( '\t' ) );
+	__m256i range = _mm256_cmpeq_epi8( _mm256_min_epu8( d, _mm256_set1_epi8( '\r' - '\t' ) ), d );
+	return _mm256_or_si256( range, _mm256_cmpeq_epi8( v, _mm256_set1_epi8( ' ' ) ) );
+}
+
+
+TIXML_ALIGNED_SCAN static const char* SkipSpacesSSE2( const char* p )
+{
+	const char* block = reinterpret_cast<const char*>( (uintptr_t)p & ~(uintptr_t)15 );
+	unsigned before = ( 1u << ( p - block ) ) - 1;		// bytes in front of p count as white space
+	for ( ;; )
+	{
+		__m128i v = _mm_load_si128( reinterpret_cast<const __m128i*>( block ) );
+		unsigned other = ~( (unsigned)_mm_movemask_epi8( Spaces( v ) ) | before ) & 0xffff;
+		if ( other )
+			return block + LowestBit( other );
+		block += 16;
+		before = 0;
+	}
+}
+
+
+TIXML_AVX2 TIXML_ALIGNED_SCAN static const char* SkipSpacesAVX2( const char* p )
+{
+	const char* block = reinterpret_cast<const char*>( (uintptr_t)p & ~(uintptr_t)31 );
+	unsigned before = ( 1u << ( p - block ) ) - 1;
+	for ( ;; )
+	{
+		__m256i v = _mm256_load_si256( reinterpret_cast<const __m256i*>( block ) );
+		unsigned other = ~( (unsigned)_mm256_movemask_epi8( Spaces( v ) ) | before );
+		if ( other )
+			return block + LowestBit( other );
+		block += 32;
+		before = 0;
+	}
+}
+
+
+TIXML_ALIGNED_SCAN static const char* FindCRSSE2( const char* p, const char* end )
+{
+	const char* block = reinterpret_cast<const char*>( (uintptr_t)p & ~(uintptr_t)15 );
+	unsigned before = ( 1u << ( p - block ) ) - 1;
+	const __m128i cr = _mm_set1_epi8( '\r' );
+	for ( ; block < end; block += 16, before = 0 )
+	{
+		__m128i v = _mm_load_si128( reinterpret_cast<const __m128i*>( block ) );
+		unsigned found = (unsigned)_mm_movemask_epi8( _mm_cmpeq_epi8( v, cr ) ) & ~before;
+		if ( found )
+		{
+			const char* r = block + LowestBit( found );
+			return r < end ? r : end;
+		}
+	}
+	return end;
+}
+
+
+TIXML_AVX2 TIXML_ALIGNED_SCAN static const char* FindCRAVX2( const char* p, const char* end )
+{
+	const char* block = reinterpret_cast<const char*>( (uintptr_t)p & ~(uintptr_t)31 );
+	unsigned before = ( 1u << ( p - block ) ) - 1;
+	const __m256i cr = _mm256_set1_epi8( '\r' );
+	for ( ; block < end; block += 32, before = 0 )
+	{
+		__m256i v = _mm256_load_si256( reinterpret_cast<const __m256i*>( block ) );
+		unsigned found = (unsigned)_mm256_movemask_epi8( _mm256_cmpeq_epi8( v, cr ) ) & ~before;
+		if ( found )
+		{
+			const char* r = block + LowestBit( found );
+			return r < end ? r : end;
+		}
+	}
+	return end;
+}
+
+
+static bool DetectAVX2()
+{
+	#ifdef _MSC_VER
+		int r[4];
+		__cpuid( r, 0 );
+		if ( r[0] < 7 )
+			return false;
+		__cpuid( r, 1 );
+		if ( !( r[2] & ( 1 << 27 ) ) || !( r[2] & ( 1 << 28 ) ) )	// OSXSAVE and AVX
+			return false;
+		if ( ( _xgetbv( 0 ) & 6 ) != 6 )		// the system saves the YMM registers
+			return false;
+		__cpuidex( r, 7, 0 );
+		return ( r[1] & ( 1 << 5 ) ) != 0;
+	#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports( "avx2" ) != 0;
+	#endif
+}
+
+
+static bool UseAVX2()
+{
+	static const bool avx2 = DetectAVX2();
+	return avx2;
+}
+
+#endif
+
+
+const char* TiXmlScan::SkipSpacesFrom( const char* p )
+{
+	#ifdef TIXML_SSE2
+		return UseAVX2() ? SkipSpacesAVX2( p ) : SkipSpacesSSE2( p );
+	#else
+		while ( IsSpace( *p ) )
+			++p;
+		return p;
+	#endif
+}
+
+
+const char* TiXmlScan::FindCR( const char* p, const char* end )
+{
+	if ( p >= end )
+		return end;
+	#ifdef TIXML_SSE2
+		return UseAVX2() ? FindCRAVX2( p, end ) : FindCRSSE2( p, end );
+	#else
+		while ( p < end && *p != '\r' )
+			++p;
+		return p;
+	#endif
+}
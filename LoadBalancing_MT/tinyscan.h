@@ -0,0 +1,65 @@
+/*
+www.sourceforge.net/projects/tinyxml
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any
+damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any
+purpose, including commercial applications, and to alter it and
+redistribute it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must
+not claim that you wrote the original software. If you use this
+software in a product, an acknowledgment in the product documentation
+would be appreciated but is not required.
+
+2. Altered source versions must be plainly marked as such, and
+must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any source
+distribution.
+*/
+
+
+#ifndef TINYXML_SCAN_INCLUDED
+#define TINYXML_SCAN_INCLUDED
+
+#include <stddef.h>
+
+/**
+	The byte scanning loops of the loader, looking at 16 or 32 bytes at a time.
+
+	On x86-64 the scans use SSE2, or AVX2 when the processor has it (checked
+	once, at the first call). Elsewhere, or with TIXML_NO_SIMD defined, they
+	are plain loops.
+
+	The vector loads are aligned to their own size, so a load never reaches
+	into a page the text does not occupy: it may read some bytes in front of
+	the text or past its end, but those are ignored and can't fault.
+*/
+class TiXmlScan
+{
+public:
+	/** Skip ' ', '\t', '\n', '\v', '\f' and '\r' (the white space of the "C" locale)
+		from p on. Returns the first other character, which may be the terminating null.
+	*/
+	static const char* SkipSpaces( const char* p )
+	{
+		// Most calls find no white space at all; they don't need a vector.
+		return IsSpace( *p ) ? SkipSpacesFrom( p ) : p;
+	}
+
+	/// Return the first '\r' in [p, end), or end if there is none.
+	static const char* FindCR( const char* p, const char* end );
+
+	static bool IsSpace( char c )
+	{
+		return c == ' ' || (unsigned char)( c - '\t' ) <= '\r' - '\t';
+	}
+
+private:
+	static const char* SkipSpacesFrom( const char* p );
+};
+
+#endif
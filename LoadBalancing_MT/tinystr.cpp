@@ -30,14 +30,20 @@ distribution.
 const TiXmlString::size_type TiXmlString::npos = static_cast< TiXmlString::size_type >(-1);
 
 
-// Null rep.
-TiXmlString::Rep TiXmlString::nullrep_ = { 0, 0, { '\0' } };
+// Characters of the empty string.
+char TiXmlString::nullstr_[1] = { '\0' };
 
 
 void TiXmlString::reserve (size_type cap)
 {
 	if (cap > capacity())
 	{
+		// The newest block of an arena can simply grow.
+		if (cap_ && TiXmlArena::Extend(str_, cap + 1))
+		{
+			cap_ = cap;
+			return;
+		}
 		TiXmlString tmp;
 		tmp.init(length(), cap);
 		memcpy(tmp.start(), data(), length());
@@ -29,6 +29,7 @@ distribution.
 
 #include <assert.h>
 #include <string.h>
+#include "tinyarena.h"
 
 /*	The support for explicit isn't that universal, and it isn't really
 	required - it is used to check that the TiXmlString class isn't incorrectly
@@ -63,26 +64,26 @@ class TiXmlString
 
 
 	// TiXmlString empty constructor
-	TiXmlString () : rep_(&nullrep_)
+	TiXmlString () : str_(nullstr_), size_(0), cap_(0)
 	{
 	}
 
 	// TiXmlString copy constructor
-	TiXmlString ( const TiXmlString & copy) : rep_(0)
+	TiXmlString ( const TiXmlString & copy)
 	{
 		init(copy.length());
 		memcpy(start(), copy.data(), length());
 	}
 
 	// TiXmlString constructor, based on a string
-	TIXML_EXPLICIT TiXmlString ( const char * copy) : rep_(0)
+	TIXML_EXPLICIT TiXmlString ( const char * copy)
 	{
 		init( static_cast<size_type>( strlen(copy) ));
 		memcpy(start(), copy, length());
 	}
 
 	// TiXmlString constructor, based on a string
-	TIXML_EXPLICIT TiXmlString ( const char * str, size_type len) : rep_(0)
+	TIXML_EXPLICIT TiXmlString ( const char * str, size_type len)
 	{
 		init(len);
 		memcpy(start(), str, len);
@@ -125,36 +126,36 @@ class TiXmlString
 
 
 	// Convert a TiXmlString into a null-terminated char *
-	const char * c_str () const { return rep_->str; }
+	const char * c_str () const { return str_; }
 
 	// Convert a TiXmlString into a char * (need not be null terminated).
-	const char * data () const { return rep_->str; }
+	const char * data () const { return str_; }
 
 	// Return the length of a TiXmlString
-	size_type length () const { return rep_->size; }
+	size_type length () const { return size_; }
 
 	// Alias for length()
-	size_type size () const { return rep_->size; }
+	size_type size () const { return size_; }
 
 	// Checks if a TiXmlString is empty
-	bool empty () const { return rep_->size == 0; }
+	bool empty () const { return size_ == 0; }
 
-	// Return capacity of string
-	size_type capacity () const { return rep_->capacity; }
+	// Return capacity of string. A borrowed string can be rewritten within its own length.
+	size_type capacity () const { return cap_ ? cap_ : size_; }
 
 
 	// single char extraction
 	const char& at (size_type index) const
 	{
 		assert( index < length() );
-		return rep_->str[ index ];
+		return str_[ index ];
 	}
 
 	// [] operator
 	char& operator [] (size_type index) const
 	{
 		assert( index < length() );
-		return rep_->str[ index ];
+		return str_[ index ];
 	}
 
 	// find a char in a string. Return TiXmlString::npos if not found
@@ -194,25 +195,39 @@ class TiXmlString
 
 	TiXmlString& append (const char* str, size_type len);
 
+	/*	Make the string refer to 'len' characters at 'str' without copying them. The
+		characters must be followed by a '\0' (it may be written after this call, as long
+		as that happens before the string is read) and stay valid for the life of the
+		string. Used by TiXmlDocument when parsing in situ. Copies of the string own
+		their characters, and so does the string itself once it has to grow.
+	*/
+	void borrow (char* str, size_type len)
+	{
+		quit();
+		str_ = str;
+		size_ = len;
+		cap_ = 0;
+	}
+
 	void swap (TiXmlString& other)
 	{
-		Rep* r = rep_;
-		rep_ = other.rep_;
-		other.rep_ = r;
+		char* s = str_;
+		str_ = other.str_;
+		other.str_ = s;
+		size_type n = size_;
+		size_ = other.size_;
+		other.size_ = n;
+		n = cap_;
+		cap_ = other.cap_;
+		other.cap_ = n;
 	}
 
   private:
 
 	void init(size_type sz) { init(sz, sz); }
-	void set_size(size_type sz) { rep_->str[ rep_->size = sz ] = '\0'; }
-	char* start() const { return rep_->str; }
-	char* finish() const { return rep_->str + rep_->size; }
-
-	struct Rep
-	{
-		size_type size, capacity;
-		char str[1];
-	};
+	void set_size(size_type sz) { str_[ size_ = sz ] = '\0'; }
+	char* start() const { return str_; }
+	char* finish() const { return str_ + size_; }
 
 	void init(size_type sz, size_type cap)
 	{
@@ -223,31 +238,33 @@ class TiXmlString
 			// doesn't work in some cases of new being overloaded. Switching
 			// to the normal allocation, although use an 'int' for systems
 			// that are overly picky about structure alignment.
-			const size_type bytesNeeded = sizeof(Rep) + cap;
-			const size_type intsNeeded = ( bytesNeeded + sizeof(int) - 1 ) / sizeof( int ); 
-			rep_ = reinterpret_cast<Rep*>( new int[ intsNeeded ] );
-
-			rep_->str[ rep_->size = sz ] = '\0';
-			rep_->capacity = cap;
+			// The buffer now comes from TiXmlArena, which returns aligned
+			// blocks from the document's arena while one is active.
+			str_ = static_cast<char*>( TiXmlArena::Allocate( cap + 1 ) );
+			str_[ size_ = sz ] = '\0';
+			cap_ = cap;
 		}
 		else
 		{
-			rep_ = &nullrep_;
+			str_ = nullstr_;
+			size_ = cap_ = 0;
 		}
 	}
 
 	void quit()
 	{
-		if (rep_ != &nullrep_)
+		if (cap_)
 		{
-			// The rep_ is really an array of ints. (see the allocator, above).
-			// Cast it back before delete, so the compiler won't incorrectly call destructors.
-			delete [] ( reinterpret_cast<int*>( rep_ ) );
+			// str_ is raw memory from TiXmlArena (see the allocator, above).
+			// The empty string and borrowed strings have no capacity of their own.
+			TiXmlArena::Free( str_ );
 		}
 	}
 
-	Rep * rep_;
-	static Rep nullrep_;
+	char * str_;
+	size_type size_;
+	size_type cap_;			// 0 for the empty and borrowed strings
+	static char nullstr_[1];
 
 } ;
 
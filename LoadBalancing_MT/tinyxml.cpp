@@ -29,7 +29,22 @@ distribution.
 #include <iostream>
 #endif
 
+#ifndef TIXML_NO_MMAP
+	#if defined(_WIN32)
+		#define WIN32_LEAN_AND_MEAN
+		#define NOMINMAX
+		#include <windows.h>
+		#include <io.h>
+		#define TIXML_MMAP
+	#elif defined(__unix__) || defined(__APPLE__)
+		#include <sys/mman.h>
+		#include <unistd.h>
+		#define TIXML_MMAP
+	#endif
+#endif
+
 #include "tinyxml.h"
+#include "tinyscan.h"
 
 FILE* TiXmlFOpen( const char* filename, const char* mode );
 
@@ -49,6 +64,60 @@ FILE* TiXmlFOpen( const char* filename, const char* mode )
 	#endif
 }
 
+
+/*	Maps the first 'length' bytes of a file copy-on-write: the file is read straight
+	from the page cache, and only the pages written to get a copy of their own. The
+	parser needs a '\0' after the text, which is the zero filled rest of the last
+	page - so a file whose length is a multiple of the page size is not mapped.
+	Returns 0 if the file can't be mapped; the caller then reads it.
+*/
+static char* TiXmlMapFile( FILE* file, size_t length )
+{
+	#if defined(TIXML_MMAP) && defined(_WIN32)
+		SYSTEM_INFO info;
+		GetSystemInfo( &info );
+		if ( length % info.dwPageSize == 0 )
+			return 0;
+		HANDLE handle = (HANDLE)_get_osfhandle( _fileno( file ) );
+		if ( handle == INVALID_HANDLE_VALUE )
+			return 0;
+		HANDLE mapping = CreateFileMapping( handle, 0, PAGE_WRITECOPY, 0, 0, 0 );
+		if ( !mapping )
+			return 0;
+		void* view = MapViewOfFile( mapping, FILE_MAP_COPY, 0, 0, length );
+		CloseHandle( mapping );		// the view keeps the mapping alive.
+		return static_cast<char*>( view );
+	#elif defined(TIXML_MMAP)
+		long page = sysconf( _SC_PAGESIZE );
+		if ( page <= 0 || length % page == 0 )
+			return 0;
+		int flags = MAP_PRIVATE;
+		#ifdef MAP_POPULATE
+		flags |= MAP_POPULATE;		// read the whole file at once, not a page per fault.
+		#endif
+		void* view = mmap( 0, length, PROT_READ | PROT_WRITE, flags, fileno( file ), 0 );
+		return view == MAP_FAILED ? 0 : static_cast<char*>( view );
+	#else
+		(void)file;
+		(void)length;
+		return 0;
+	#endif
+}
+
+
+static void TiXmlUnmapFile( char* view, size_t length )
+{
+	#if defined(TIXML_MMAP) && defined(_WIN32)
+		(void)length;
+		UnmapViewOfFile( view );
+	#elif defined(TIXML_MMAP)
+		munmap( view, length );
+	#else
+		(void)view;
+		(void)length;
+	#endif
+}
+
 void TiXmlBase::EncodeString( const TIXML_STRING& str, TIXML_STRING* outString )
 {
 	int i=0;
@@ -914,6 +983,10 @@ TiXmlDocument::TiXmlDocument() : TiXmlNode( TiXmlNode::TINYXML_DOCUMENT )
 {
 	tabsize = 4;
 	useMicrosoftBOM = false;
+	useArena = false;
+	buffer = 0;
+	bufferMapped = 0;
+	parseInSitu = inSitu = false;
 	ClearError();
 }
 
@@ -921,6 +994,10 @@ TiXmlDocument::TiXmlDocument( const char * documentName ) : TiXmlNode( TiXmlNode
 {
 	tabsize = 4;
 	useMicrosoftBOM = false;
+	useArena = false;
+	buffer = 0;
+	bufferMapped = 0;
+	parseInSitu = inSitu = false;
 	value = documentName;
 	ClearError();
 }
@@ -931,6 +1008,10 @@ TiXmlDocument::TiXmlDocument( const std::string& documentName ) : TiXmlNode( TiX
 {
 	tabsize = 4;
 	useMicrosoftBOM = false;
+	useArena = false;
+	buffer = 0;
+	bufferMapped = 0;
+	parseInSitu = inSitu = false;
     value = documentName;
 	ClearError();
 }
@@ -939,6 +1020,10 @@ TiXmlDocument::TiXmlDocument( const std::string& documentName ) : TiXmlNode( TiX
 
 TiXmlDocument::TiXmlDocument( const TiXmlDocument& copy ) : TiXmlNode( TiXmlNode::TINYXML_DOCUMENT )
 {
+	useArena = false;
+	buffer = 0;
+	bufferMapped = 0;
+	parseInSitu = inSitu = false;
 	copy.CopyTo( this );
 }
 
@@ -946,6 +1031,7 @@ TiXmlDocument::TiXmlDocument( const TiXmlDocument& copy ) : TiXmlNode( TiXmlNode
 TiXmlDocument& TiXmlDocument::operator=( const TiXmlDocument& copy )
 {
 	Clear();
+	FreeBuffer();
 	copy.CopyTo( this );
 	return *this;
 }
@@ -994,6 +1080,7 @@ bool TiXmlDocument::LoadFile( FILE* file, TiXmlEncoding encoding )
 	// Delete the existing data:
 	Clear();
 	location.Clear();
+	FreeBuffer();
 
 	// Get the file size, so we can pre-allocate the string. HUGE speed impact.
 	long length = 0;
@@ -1029,13 +1116,21 @@ bool TiXmlDocument::LoadFile( FILE* file, TiXmlEncoding encoding )
 	}
 	*/
 
-	char* buf = new char[ length+1 ];
-	buf[0] = 0;
+	// A mapped file is parsed where it lies in the page cache. Otherwise it is read.
+	size_t mapped = length;
+	char* buf = TiXmlMapFile( file, length );
+	if ( !buf )
+	{
+		mapped = 0;
+		buf = new char[ length+1 ];
+		buf[0] = 0;
 
-	if ( fread( buf, length, 1, file ) != 1 ) {
-		delete [] buf;
-		SetError( TIXML_ERROR_OPENING_FILE, 0, 0, TIXML_ENCODING_UNKNOWN );
-		return false;
+		if ( fread( buf, length, 1, file ) != 1 ) {
+			delete [] buf;
+			SetError( TIXML_ERROR_OPENING_FILE, 0, 0, TIXML_ENCODING_UNKNOWN );
+			return false;
+		}
+		buf[length] = 0;
 	}
 
 	// Process the buffer in place to normalize new lines. (See comment above.)
@@ -1049,38 +1144,68 @@ bool TiXmlDocument::LoadFile( FILE* file, TiXmlEncoding encoding )
     //		* CR+LF: DEC RT-11 and most other early non-Unix, non-IBM OSes, CP/M, MP/M, DOS, OS/2, Microsoft Windows, Symbian OS
     //		* CR:    Commodore 8-bit machines, Apple II family, Mac OS up to version 9 and OS-9
 
-	const char* p = buf;	// the read head
-	char* q = buf;			// the write head
+	//
+	// Most files have no CR at all. Nothing before the first one changes, so
+	// the pass starts there - and a mapped file is not written to (copied) otherwise.
+	// The runs between CRs are found a vector at a time (TiXmlScan) and moved as a whole.
+
 	const char CR = 0x0d;
 	const char LF = 0x0a;
+	const char* end = buf + length;
+	const char* p = TiXmlScan::FindCR( buf, end );	// the read head
+	char* q = buf + ( p - buf );					// the write head
 
-	buf[length] = 0;
-	while( *p ) {
-		assert( p < (buf+length) );
-		assert( q <= (buf+length) );
-		assert( q <= p );
+	if ( p < end ) {
+		while ( p < end ) {
+			assert( *p == CR );
+			assert( q <= p );
 
-		if ( *p == CR ) {
 			*q++ = LF;
 			p++;
-			if ( *p == LF ) {		// check for CR+LF (and skip LF)
+			if ( p < end && *p == LF ) {		// check for CR+LF (and skip LF)
 				p++;
 			}
+			const char* next = TiXmlScan::FindCR( p, end );
+			memmove( q, p, next - p );
+			q += next - p;
+			p = next;
 		}
-		else {
-			*q++ = *p++;
-		}
+		assert( q <= (buf+length) );
+		*q = 0;
 	}
-	assert( q <= (buf+length) );
-	*q = 0;
 
+	#ifndef TIXML_USE_STL
+	if ( parseInSitu )
+	{
+		// The nodes will refer to the buffer, so it stays with the document.
+		buffer = buf;
+		inSitu = true;
+	}
+	#endif
 	Parse( buf, 0, encoding );
+	inSitu = false;
 
-	delete [] buf;
+	if ( buf == buffer )
+		bufferMapped = mapped;
+	else if ( mapped )
+		TiXmlUnmapFile( buf, mapped );
+	else
+		delete [] buf;
 	return !Error();
 }
 
 
+void TiXmlDocument::FreeBuffer()
+{
+	if ( bufferMapped )
+		TiXmlUnmapFile( buffer, bufferMapped );
+	else
+		delete [] buffer;
+	buffer = 0;
+	bufferMapped = 0;
+}
+
+
 bool TiXmlDocument::SaveFile( const char * filename ) const
 {
 	// The old c stuff lives on...
@@ -37,6 +37,7 @@ distribution.
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include "tinyarena.h"
 
 // Help out windows:
 #if defined( _DEBUG ) && !defined( DEBUG )
@@ -201,6 +202,13 @@ public:
 	TiXmlBase()	:	userData(0)		{}
 	virtual ~TiXmlBase()			{}
 
+	/**	Nodes and attributes are allocated through TiXmlArena, so that a
+		document being parsed with an arena (see TiXmlDocument::SetUseArena)
+		takes them from the arena. Outside of that they come from the heap.
+	*/
+	static void* operator new( size_t size )	{ return TiXmlArena::Allocate( size ); }
+	static void operator delete( void* p )		{ TiXmlArena::Free( p ); }
+
 	/**	All TinyXml classes can print themselves to a filestream
 		or the string class (TiXmlString in non-STL mode, std::string
 		in STL mode.) Either or both cfile and str can be null.
@@ -305,9 +313,11 @@ protected:
 
 	/*	Reads an XML name into the string provided. Returns
 		a pointer just past the last character of the name,
-		or 0 if the function has an error.
+		or 0 if the function has an error. In situ, the string
+		borrows the name from the text instead of copying it,
+		and the caller has to terminate it.
 	*/
-	static const char* ReadName( const char* p, TIXML_STRING* name, TiXmlEncoding encoding );
+	static const char* ReadName( const char* p, TIXML_STRING* name, TiXmlEncoding encoding, bool inSitu = false );
 
 	/*	Reads text. Returns a pointer past the given end tag.
 		Wickedly complex options, but it keeps the (sensitive) code in one place.
@@ -1406,7 +1416,8 @@ public:
 	TiXmlDocument( const TiXmlDocument& copy );
 	TiXmlDocument& operator=( const TiXmlDocument& copy );
 
-	virtual ~TiXmlDocument() {}
+	/// The nodes are deleted here, while the arena and the buffer they may live in still exist.
+	virtual ~TiXmlDocument() { Clear(); FreeBuffer(); }
 
 	/** Load a file using the current document value.
 		Returns true if successful. Will delete any existing
@@ -1423,6 +1434,9 @@ public:
 		doesn't stream - the entire object pointed at by the FILE*
 		will be interpreted as an XML file. TinyXML doesn't stream in XML from the current
 		file location. Streaming may be added in the future.
+
+		Where possible the file is mapped into memory (copy-on-write) rather than
+		read into a buffer; define TIXML_NO_MMAP to always read it.
 	*/
 	bool LoadFile( FILE*, TiXmlEncoding encoding = TIXML_DEFAULT_ENCODING );
 	/// Save a file using the given FILE*. Returns true if successful.
@@ -1505,6 +1519,38 @@ public:
 
 	int TabSize() const	{ return tabsize; }
 
+	/** SetUseArena() makes the following Parse() or LoadFile() allocate the
+		nodes, attributes and strings it creates from an arena owned by this
+		document (see TiXmlArena), instead of one heap allocation each.
+		The arena is released in one piece when the document is destroyed.
+
+		Memory of nodes removed or cleared from the document is not reused
+		until then, so an arena suits documents that are loaded, read and
+		thrown away. Nodes of the document must not outlive it.
+	*/
+	void SetUseArena( bool _useArena )	{ useArena = _useArena; }
+
+	bool UseArena() const	{ return useArena; }
+	/// Bytes taken from the arena so far.
+	size_t ArenaUsed() const	{ return arena.Used(); }
+
+	/** SetParseInSitu() makes the following LoadFile() parse the text of the
+		file in place. The document keeps the buffer the file was read into,
+		and the names of elements and attributes, and attribute values without
+		entities, refer to it instead of being copied: each one is ended by a
+		'\0' written over the character that followed it (a quote, '=', '/',
+		'>' or white space) once the parser is past that character.
+
+		The strings become copies of their own when they are changed. Parse()
+		called directly always copies, as it does not own the text.
+		Not available with TIXML_USE_STL, where the option is ignored.
+	*/
+	void SetParseInSitu( bool _parseInSitu )	{ parseInSitu = _parseInSitu; }
+
+	bool ParseInSitu() const	{ return parseInSitu; }
+	// [internal use] True while LoadFile() parses the buffer of the document in situ.
+	bool InSitu() const			{ return inSitu; }
+
 	/** If you have handled the error, it can be reset with this call. The error
 		state is automatically cleared if you Parse a new XML block.
 	*/
@@ -1545,7 +1591,14 @@ protected :
 
 private:
 	void CopyTo( TiXmlDocument* target ) const;
-
+	void FreeBuffer();
+
+	TiXmlArena arena;			// declared first, so it is destroyed after everything it may hold.
+	bool useArena;
+	char* buffer;				// the text of the last LoadFile() in situ; the nodes refer to it.
+	size_t bufferMapped;		// the length of the file, if buffer is mapped. 0 if it is from new[].
+	bool parseInSitu;
+	bool inSitu;
 	bool error;
 	int  errorId;
 	TIXML_STRING errorDesc;
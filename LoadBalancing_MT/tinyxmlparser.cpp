@@ -26,6 +26,7 @@ distribution.
 #include <stddef.h>
 
 #include "tinyxml.h"
+#include "tinyscan.h"
 
 //#define DEBUG_PARSER
 #if defined( DEBUG_PARSER )
@@ -173,6 +174,8 @@ class TiXmlParsingData
 	friend class TiXmlDocument;
   public:
 	void Stamp( const char* now, TiXmlEncoding encoding );
+	// Write the '\0' that ends a name or value parsed in situ over the character at 'end'.
+	void Terminate( char* end, TiXmlEncoding encoding );
 
 	const TiXmlCursor& Cursor() const	{ return cursor; }
 
@@ -185,14 +188,78 @@ class TiXmlParsingData
 		tabsize = _tabsize;
 		cursor.row = row;
 		cursor.col = col;
+		terminated = 0;
+	}
+
+	enum { MAX_TERMINATED = 4 };
+
+	// The character Terminate() replaced at p, or 0 if p is not such an end.
+	char Terminated( const char* p ) const
+	{
+		for ( int i = 0; i < terminated; ++i )
+		{
+			if ( terminatedAt[i] == p )
+				return terminatedChar[i];
+		}
+		return 0;
 	}
 
 	TiXmlCursor		cursor;
 	const char*		stamp;
 	int				tabsize;
+	// Ends written by Terminate() that Stamp may not have passed yet, and the
+	// characters they replaced. Stamp steps over these nulls, and only these.
+	const char*		terminatedAt[MAX_TERMINATED];
+	char			terminatedChar[MAX_TERMINATED];
+	int				terminated;
 };
 
 
+void TiXmlParsingData::Terminate( char* end, TiXmlEncoding encoding )
+{
+	if ( tabsize >= 1 )
+	{
+		// Forget the ends the stamp has passed already.
+		int n = 0;
+		for ( int i = 0; i < terminated; ++i )
+		{
+			if ( terminatedAt[i] >= stamp )
+			{
+				terminatedAt[n] = terminatedAt[i];
+				terminatedChar[n++] = terminatedChar[i];
+			}
+		}
+		terminated = n;
+
+		if ( terminated < MAX_TERMINATED )
+		{
+			terminatedAt[terminated] = end;
+			terminatedChar[terminated++] = *end;
+		}
+		else
+		{
+			Stamp( end+1, encoding );		// too many: count it now.
+		}
+	}
+	*end = 0;
+}
+
+
+// In situ, ends a borrowed name or value with a '\0' at 'end', once the parser
+// is past that character - or, after an error, before the parse is given up,
+// so that nothing left in the document runs on into the rest of the text.
+static void TerminateInSitu( char*& end, TiXmlParsingData* data, TiXmlEncoding encoding )
+{
+	if ( !end )
+		return;
+	if ( data )
+		data->Terminate( end, encoding );
+	else
+		*end = 0;
+	end = 0;
+}
+
+
 void TiXmlParsingData::Stamp( const char* now, TiXmlEncoding encoding )
 {
 	assert( now );
@@ -217,9 +284,33 @@ void TiXmlParsingData::Stamp( const char* now, TiXmlEncoding encoding )
 		// Code contributed by Fletcher Dunn: (modified by lee)
 		switch (*pU) {
 			case 0:
-				// We *should* never get here, but in case we do, don't
-				// advance past the terminating null character, ever
-				return;
+				// The end of a name or value written in situ counts as the
+				// character it replaced (see Terminate).
+				switch ( Terminated( p ) )
+				{
+					case 0:
+						// We *should* never get here, but in case we do, don't
+						// advance past the terminating null character, ever
+						return;
+
+					case '\n':
+					case '\r':
+						++row;
+						col = 0;
+						++p;
+						break;
+
+					case '\t':
+						++p;
+						col = (col / tabsize + 1) * tabsize;
+						break;
+
+					default:
+						++p;
+						++col;
+						break;
+				}
+				break;
 
 			case '\r':
 				// bump down to the next line
@@ -321,6 +412,8 @@ const char* TiXmlBase::SkipWhiteSpace( const char* p, TiXmlEncoding encoding )
 	{
 		while ( *p )
 		{
+			// Runs of plain white space are skipped a vector at a time.
+			p = TiXmlScan::SkipSpaces( p );
 			const unsigned char* pU = (const unsigned char*)p;
 			
 			// Skip the stupid Microsoft UTF-8 Byte order marks
@@ -354,6 +447,8 @@ const char* TiXmlBase::SkipWhiteSpace( const char* p, TiXmlEncoding encoding )
 	}
 	else
 	{
+		// The scalar loop is left with any white space of other locales.
+		p = TiXmlScan::SkipSpaces( p );
 		while ( *p && IsWhiteSpace( *p ) )
 			++p;
 	}
@@ -398,7 +493,7 @@ const char* TiXmlBase::SkipWhiteSpace( const char* p, TiXmlEncoding encoding )
 // One of TinyXML's more performance demanding functions. Try to keep the memory overhead down. The
 // "assign" optimization removes over 10% of the execution time.
 //
-const char* TiXmlBase::ReadName( const char* p, TIXML_STRING * name, TiXmlEncoding encoding )
+const char* TiXmlBase::ReadName( const char* p, TIXML_STRING * name, TiXmlEncoding encoding, bool inSitu )
 {
 	// Oddly, not supported on some comilers,
 	//name->clear();
@@ -428,6 +523,13 @@ const char* TiXmlBase::ReadName( const char* p, TIXML_STRING * name, TiXmlEncodi
 			++p;
 		}
 		if ( p-start > 0 ) {
+			#ifndef TIXML_USE_STL
+			if ( inSitu )
+				name->borrow( const_cast<char*>( start ), p-start );
+			else
+			#else
+			(void)inSitu;		// never in situ with TIXML_USE_STL
+			#endif
 			name->assign( start, p-start );
 		}
 		return p;
@@ -703,6 +805,9 @@ void TiXmlDocument::StreamIn( std::istream * in, TIXML_STRING * tag )
 
 const char* TiXmlDocument::Parse( const char* p, TiXmlParsingData* prevData, TiXmlEncoding encoding )
 {
+	// Everything created while parsing comes from the arena, if there is one.
+	TiXmlArena::Scope scope( useArena ? &arena : 0 );
+
 	ClearError();
 
 	// Parse away, at the document level. Since a document
@@ -1067,16 +1172,19 @@ const char* TiXmlElement::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 
 	// Read the name.
 	const char* pErr = p;
+	bool inSitu = document && document->InSitu();
 
-    p = ReadName( p, &value, encoding );
+    p = ReadName( p, &value, encoding, inSitu );
 	if ( !p || !*p )
 	{
 		if ( document )	document->SetError( TIXML_ERROR_FAILED_TO_READ_ELEMENT_NAME, pErr, data, encoding );
 		return 0;
 	}
+	// In situ, the name is terminated as soon as the character after it has been looked at.
+	char* nameEnd = inSitu ? const_cast<char*>( p ) : 0;
 
-    TIXML_STRING endTag ("</");
-	endTag += value;
+	// The end tag is "</" followed by the name. It is matched in place,
+	// rather than built as a string for every element.
 
 	// Check for and read attributes. Also look for an empty
 	// tag or an end tag.
@@ -1087,11 +1195,15 @@ const char* TiXmlElement::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 		if ( !p || !*p )
 		{
 			if ( document ) document->SetError( TIXML_ERROR_READING_ATTRIBUTES, pErr, data, encoding );
+			TerminateInSitu( nameEnd, data, encoding );
 			return 0;
 		}
+		if ( nameEnd && p > nameEnd )
+			TerminateInSitu( nameEnd, data, encoding );
 		if ( *p == '/' )
 		{
 			++p;
+			TerminateInSitu( nameEnd, data, encoding );
 			// Empty tag.
 			if ( *p  != '>' )
 			{
@@ -1106,6 +1218,7 @@ const char* TiXmlElement::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 			// Read the value -- which can include other
 			// elements -- read the end tag, and return.
 			++p;
+			TerminateInSitu( nameEnd, data, encoding );
 			p = ReadValue( p, data, encoding );		// Note this is an Element method, and will set the error if one happens.
 			if ( !p || !*p ) {
 				// We were looking for the end tag, but found nothing.
@@ -1119,9 +1232,9 @@ const char* TiXmlElement::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 			// </foo > and
 			// </foo> 
 			// are both valid end tags.
-			if ( StringEqual( p, endTag.c_str(), false, encoding ) )
+			if ( p[0] == '<' && p[1] == '/' && p[2] && StringEqual( p+2, value.c_str(), false, encoding ) )
 			{
-				p += endTag.length();
+				p += 2 + value.length();
 				p = SkipWhiteSpace( p, encoding );
 				if ( p && *p && *p == '>' ) {
 					++p;
@@ -1142,6 +1255,7 @@ const char* TiXmlElement::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 			TiXmlAttribute* attrib = new TiXmlAttribute();
 			if ( !attrib )
 			{
+				TerminateInSitu( nameEnd, data, encoding );
 				return 0;
 			}
 
@@ -1153,6 +1267,7 @@ const char* TiXmlElement::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 			{
 				if ( document ) document->SetError( TIXML_ERROR_PARSING_ELEMENT, pErr, data, encoding );
 				delete attrib;
+				TerminateInSitu( nameEnd, data, encoding );
 				return 0;
 			}
 
@@ -1166,12 +1281,14 @@ const char* TiXmlElement::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 			{
 				if ( document ) document->SetError( TIXML_ERROR_PARSING_ELEMENT, pErr, data, encoding );
 				delete attrib;
+				TerminateInSitu( nameEnd, data, encoding );
 				return 0;
 			}
 
 			attributeSet.Add( attrib );
 		}
 	}
+	TerminateInSitu( nameEnd, data, encoding );
 	return p;
 }
 
@@ -1401,16 +1518,19 @@ const char* TiXmlAttribute::Parse( const char* p, TiXmlParsingData* data, TiXmlE
 	}
 	// Read the name, the '=' and the value.
 	const char* pErr = p;
-	p = ReadName( p, &name, encoding );
+	bool inSitu = document && document->InSitu();
+	p = ReadName( p, &name, encoding, inSitu );
 	if ( !p || !*p )
 	{
 		if ( document ) document->SetError( TIXML_ERROR_READING_ATTRIBUTES, pErr, data, encoding );
 		return 0;
 	}
+	char* nameEnd = inSitu ? const_cast<char*>( p ) : 0;
 	p = SkipWhiteSpace( p, encoding );
 	if ( !p || !*p || *p != '=' )
 	{
 		if ( document ) document->SetError( TIXML_ERROR_READING_ATTRIBUTES, p, data, encoding );
+		TerminateInSitu( nameEnd, data, encoding );
 		return 0;
 	}
 
@@ -1419,6 +1539,7 @@ const char* TiXmlAttribute::Parse( const char* p, TiXmlParsingData* data, TiXmlE
 	if ( !p || !*p )
 	{
 		if ( document ) document->SetError( TIXML_ERROR_READING_ATTRIBUTES, p, data, encoding );
+		TerminateInSitu( nameEnd, data, encoding );
 		return 0;
 	}
 	
@@ -1426,6 +1547,24 @@ const char* TiXmlAttribute::Parse( const char* p, TiXmlParsingData* data, TiXmlE
 	const char SINGLE_QUOTE = '\'';
 	const char DOUBLE_QUOTE = '\"';
 
+	#ifndef TIXML_USE_STL
+	if ( inSitu && ( *p == SINGLE_QUOTE || *p == DOUBLE_QUOTE ) )
+	{
+		// A value without entities is borrowed as it is; the closing quote becomes its end.
+		const char* q = p+1;
+		while ( *q && *q != *p && *q != '&' )
+			++q;
+		if ( *q == *p )
+		{
+			value.borrow( const_cast<char*>( p+1 ), q-p-1 );
+			TerminateInSitu( nameEnd, data, encoding );
+			char* valueEnd = const_cast<char*>( q );
+			TerminateInSitu( valueEnd, data, encoding );
+			return q+1;
+		}
+	}
+	#endif
+
 	if ( *p == SINGLE_QUOTE )
 	{
 		++p;
@@ -1453,12 +1592,14 @@ const char* TiXmlAttribute::Parse( const char* p, TiXmlParsingData* data, TiXmlE
 				// We did not have an opening quote but seem to have a 
 				// closing one. Give up and throw an error.
 				if ( document ) document->SetError( TIXML_ERROR_READING_ATTRIBUTES, p, data, encoding );
+				TerminateInSitu( nameEnd, data, encoding );
 				return 0;
 			}
 			value += *p;
 			++p;
 		}
 	}
+	TerminateInSitu( nameEnd, data, encoding );
 	return p;
 }
 
@@ -0,0 +1,107 @@
+/*
+	Regression test for parsing in situ (TiXmlDocument::SetParseInSitu).
+
+	Every input is loaded once copying and once in situ, with and without the
+	arena. The documents must come out the same: the same error and error
+	location, the same names and values, and the same printed text - also for
+	malformed input, where the parse stops with borrowed names still open.
+
+	Build and run from the repository root:
+		g++ -std=c++14 -I LoadBalancing_MT tests/xmltest_insitu.cpp LoadBalancing_MT/tiny*.cpp -o xmltest_insitu
+		./xmltest_insitu
+*/
+
+#include "tinyxml.h"
+#include <stdio.h>
+#include <string>
+
+static int failures = 0;
+
+static std::string Describe( const TiXmlNode* node )
+{
+	std::string out;
+	for ( const TiXmlNode* c = node->FirstChild(); c; c = c->NextSibling() )
+	{
+		char loc[64];
+		sprintf( loc, " @%d:%d\n", c->Row(), c->Column() );
+		out += std::string( "[" ) + c->Value() + "]" + loc;
+		if ( const TiXmlElement* e = c->ToElement() )
+		{
+			for ( const TiXmlAttribute* a = e->FirstAttribute(); a; a = a->Next() )
+			{
+				sprintf( loc, " @%d:%d\n", a->Row(), a->Column() );
+				out += std::string( "  " ) + a->Name() + "=[" + a->Value() + "]" + loc;
+			}
+		}
+		out += Describe( c );
+	}
+	return out;
+}
+
+static std::string Load( const char* file, bool arena, bool inSitu )
+{
+	TiXmlDocument doc( file );
+	doc.SetUseArena( arena );
+	doc.SetParseInSitu( inSitu );
+	char error[128] = "ok\n";
+	if ( !doc.LoadFile() )
+		sprintf( error, "error %d at %d:%d\n", doc.ErrorId(), doc.ErrorRow(), doc.ErrorCol() );
+
+	TiXmlPrinter printer;
+	doc.Accept( &printer );
+	return error + Describe( &doc ) + printer.CStr();
+}
+
+static void Check( const char* name, const char* text, size_t length )
+{
+	const char* file = "xmltest_insitu.xml";
+	FILE* fp = fopen( file, "wb" );
+	if ( !fp || fwrite( text, 1, length, fp ) != length )
+	{
+		printf( "%s: cannot write %s\n", name, file );
+		++failures;
+		return;
+	}
+	fclose( fp );
+
+	std::string copied = Load( file, false, false );
+	for ( int arena = 0; arena < 2; ++arena )
+	{
+		std::string parsed = Load( file, arena != 0, true );
+		if ( parsed != copied )
+		{
+			printf( "%s (arena %d) differs.\ncopied:\n%s\nin situ:\n%s\n", name, arena, copied.c_str(), parsed.c_str() );
+			++failures;
+		}
+	}
+	remove( file );
+}
+
+#define CHECK( name, text )	Check( name, text, sizeof( text ) - 1 )
+
+int main()
+{
+	// Well formed input.
+	CHECK( "attributes", "<root a=\"1\"\tb = 'two'\n c=\"x&amp;y\" d=un>\n<e\n/><f/><g x=\"&lt;\"></g>\n<h  y=\"\"  >text</h></root>\n" );
+	CHECK( "crlf", "<a>\r\n<b x=\"1\"\r\n\ty='2'/>\r\n</a>\r\n" );
+
+	// Errors with borrowed names still open.
+	CHECK( "bad attribute", "<Program>\n<Pro&ram\tlimit0 \n  =\n'&lt;x&gt;' />\n</Program>\n" );
+	CHECK( "bad name", "<roo<\nx11 = \"1\" />\n" );
+	CHECK( "no '='", "<a b c=\"1\"/>" );
+	CHECK( "nothing after '='", "<a b=" );
+	CHECK( "stray quote", "<a b=c\"d\"/>" );
+	CHECK( "end of text in tag", "<a b=\"1\" " );
+	CHECK( "duplicate attribute", "<a b=\"1\"\n  b\t= \"2\"/>" );
+	CHECK( "bad end tag", "<a><b x=\"1\"></c></a>" );
+
+	// Nulls in the text stop the parse where they are.
+	CHECK( "null", "<a>\r\n<b/>\r\n<c/>\r\n\0<d/>\r\n<e>\r\n<f x=\"1\"\r\n</a>\r\n" );
+	CHECK( "null in end tag", "<a >\n<bb >\ttxt</\0b>  <e:f />\t</a>" );
+
+	if ( failures )
+		printf( "%d failed\n", failures );
+	else
+		printf( "passed\n" );
+	return failures ? 1 : 0;
+}